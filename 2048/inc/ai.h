@@ -0,0 +1,47 @@
+#ifndef AI_H
+#define AI_H
+
+/**
+ * @file ai.h
+ * @brief Expectimax move search for the hint and autoplay modes.
+ *
+ * Searches the four moves and every 2/4 spawn on the packed bitboard,
+ * deepening one move at a time until a wall-clock budget runs out.
+ */
+
+#include "bitboard.h"
+#include "game.h"
+#include <stdint.h>
+
+/**
+ * @brief Statistics of the last ai_best_move() call.
+ */
+struct ai_stats {
+    uint32_t nodes;      /**< Max and chance nodes visited, all iterations. */
+    uint32_t elapsed_us; /**< Wall-clock time spent searching. */
+    uint8_t  depth;      /**< Deepest fully completed search, in moves. */
+};
+
+/**
+ * @brief Prepare the search.
+ *
+ * Builds the bitboard tables and, with CONFIG_2048_AI_NTUPLE, loads the
+ * N-tuple weights (falling back to the heuristic if the blob is invalid).
+ */
+void ai_init(void);
+
+/**
+ * @brief Pick the best move for a board within a time budget.
+ *
+ * Runs iterative-deepening expectimax from depth 1 up to
+ * CONFIG_2048_AI_MAX_DEPTH. A search that hits the deadline is discarded
+ * and the move from the last completed depth is returned.
+ *
+ * @param b         Board to search from.
+ * @param budget_ms Hard deadline for the whole call, in milliseconds.
+ * @param stats     Optional output for nodes, time and depth reached.
+ * @return The best move, or MOVE_NONE if no move is possible.
+ */
+enum move_dir ai_best_move(bb_board_t b, uint32_t budget_ms, struct ai_stats *stats);
+
+#endif /* AI_H */
@@ -0,0 +1,41 @@
+#ifndef ANIM_H
+#define ANIM_H
+
+/**
+ * @file anim.h
+ * @brief Slide and pop animations driven by the engine's move deltas.
+ *
+ * Moving tiles are drawn by a fixed pool of ghost tiles created once by
+ * anim_init(); a move never creates or deletes LVGL objects.
+ */
+
+#include "game.h"
+
+/**
+ * @brief Create the ghost tile pool on top of the board.
+ *
+ * Call after every create_board(); the pool is deleted with the board.
+ */
+void anim_init(void);
+
+/**
+ * @brief Animate the events of a move on top of the already updated board.
+ *
+ * Call right after update_ui(). Destination and spawn cells are shown
+ * empty while ghost tiles slide in, then repainted from grid[][]; merged
+ * and spawned tiles pop. A move with more moving tiles than the pool
+ * holds snaps into place and only pops.
+ *
+ * @param md Events of the move, usually &last_deltas.
+ */
+void anim_play(const struct move_deltas *md);
+
+/**
+ * @brief Stop any running animation and show the board as in grid[][].
+ *
+ * Cheap when nothing runs; call before applying the next move so input
+ * never waits for an animation.
+ */
+void anim_cancel(void);
+
+#endif /* ANIM_H */
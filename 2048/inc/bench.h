@@ -0,0 +1,20 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * @file bench.h
+ * @brief On-device move engine benchmark for the Zephyr‑2048 project.
+ */
+
+/**
+ * @brief Time the move kernel of every board size and print moves/s.
+ *
+ * For each size GRID_MIN..GRID_MAX, plays random games to collect a pool
+ * of mid-game boards, then times CONFIG_2048_BENCH_MOVES move_tiles()
+ * calls on copies of them (the copy and grid_changed() are timed separately
+ * and subtracted).
+ * Clobbers grid[][] and grid_size; run it before starting a game.
+ */
+void bench_run(void);
+
+#endif /* BENCH_H */
@@ -0,0 +1,148 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+/**
+ * @file bitboard.h
+ * @brief Packed 64-bit board engine for the Zephyr‑2048 project.
+ *
+ * Stores a 4×4 board as sixteen 4-bit tile exponents in one 64-bit word
+ * (0 = empty, k = tile 2^k). Cell (r, c) lives in nibble r*4 + c, so each
+ * row is one 16-bit lane. Left/right moves are table lookups per row and
+ * up/down moves transpose around them. Used by the search features where
+ * the grid[][] engine in game.c is too slow to call millions of times.
+ */
+
+#include "config.h"
+#include "game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/** A packed board: sixteen 4-bit exponents, row 0 in the low 16 bits. */
+typedef uint64_t bb_board_t;
+
+/** Largest exponent a nibble can hold (tile 32768). Two such tiles never merge. */
+#define BB_MAX_EXP 15
+
+/**
+ * @brief Build the row move table.
+ *
+ * Must be called once before any bb_move_*() call. Safe to call again.
+ */
+void bb_init(void);
+
+/**
+ * @brief Pack the top-left 4×4 of a grid[][]-style board into a bb_board_t.
+ *
+ * @param g Board of tile values (0 or powers of two up to 2^BB_MAX_EXP).
+ * @return The packed board.
+ */
+bb_board_t bb_from_grid(const int g[GRID_MAX][GRID_MAX]);
+
+/**
+ * @brief Unpack a bb_board_t into the top-left 4×4 of a grid[][]-style board.
+ *
+ * @param b Packed board.
+ * @param g Destination board.
+ */
+void bb_to_grid(bb_board_t b, int g[GRID_MAX][GRID_MAX]);
+
+/**
+ * @brief Get the exponent stored at (r, c).
+ */
+static inline int bb_get_exp(bb_board_t b, int r, int c)
+{
+    return (int)((b >> (4 * (r * 4 + c))) & 0xF);
+}
+
+/**
+ * @brief Merge score accumulated to reach this board from 2-tiles only.
+ *
+ * A 2^k tile counts (k-1)*2^k points. A move's merge reward is exactly
+ * bb_score(after) - bb_score(before), because moves never spawn tiles.
+ */
+static inline uint32_t bb_score(bb_board_t b)
+{
+    uint32_t score = 0;
+
+    for (int i = 0; i < 16; i++, b >>= 4) {
+        uint32_t e = (uint32_t)(b & 0xF);
+        if (e >= 2) {
+            score += (e - 1) << e;
+        }
+    }
+    return score;
+}
+
+/**
+ * @brief Swap rows and columns of a packed board.
+ */
+static inline bb_board_t bb_transpose(bb_board_t x)
+{
+    bb_board_t a1 = x & 0xF0F00F0FF0F00F0FULL;
+    bb_board_t a2 = x & 0x0000F0F00000F0F0ULL;
+    bb_board_t a3 = x & 0x0F0F00000F0F0000ULL;
+    bb_board_t a  = a1 | (a2 << 12) | (a3 >> 12);
+    bb_board_t b1 = a & 0xFF00FF0000FF00FFULL;
+    bb_board_t b2 = a & 0x00FF00FF00000000ULL;
+    bb_board_t b3 = a & 0x00000000FF00FF00ULL;
+
+    return b1 | (b2 >> 24) | (b3 << 24);
+}
+
+/**
+ * @brief Shift and merge all rows to the left.
+ * @return The resulting board (equal to @p b if nothing moved).
+ */
+bb_board_t bb_move_left(bb_board_t b);
+
+/**
+ * @brief Shift and merge all rows to the right.
+ * @return The resulting board (equal to @p b if nothing moved).
+ */
+bb_board_t bb_move_right(bb_board_t b);
+
+/**
+ * @brief Shift and merge all columns upward.
+ * @return The resulting board (equal to @p b if nothing moved).
+ */
+bb_board_t bb_move_up(bb_board_t b);
+
+/**
+ * @brief Shift and merge all columns downward.
+ * @return The resulting board (equal to @p b if nothing moved).
+ */
+bb_board_t bb_move_down(bb_board_t b);
+
+/**
+ * @brief Apply the move for @p dir (MOVE_LEFT … MOVE_DOWN).
+ * @return The resulting board, or @p b unchanged for MOVE_NONE.
+ */
+bb_board_t bb_move(bb_board_t b, enum move_dir dir);
+
+/**
+ * @brief Count the empty cells of a packed board.
+ */
+int bb_count_empty(bb_board_t b);
+
+/**
+ * @brief Check if any move is possible on a packed board.
+ *
+ * @return true if at least one move remains possible, false if the game is over.
+ */
+bool bb_can_move(bb_board_t b);
+
+/**
+ * @brief Add one new tile (2 or 4) at a random empty position.
+ *
+ * Uses the same rule as spawn_tile(): the @p rnd_pos % empties'th empty cell
+ * in row-major order receives a 4 if @p rnd_val % 10 == 0, else a 2. Feeding
+ * both functions the same random words therefore gives the same board.
+ *
+ * @param b       Packed board.
+ * @param rnd_pos Random word selecting the cell.
+ * @param rnd_val Random word selecting the tile value.
+ * @return The board with the new tile, or @p b if it was full.
+ */
+bb_board_t bb_spawn_tile(bb_board_t b, uint32_t rnd_pos, uint32_t rnd_val);
+
+#endif /* BITBOARD_H */
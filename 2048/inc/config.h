@@ -7,8 +7,9 @@
  #ifndef CONFIG_H
  #define CONFIG_H
  
- /* Grid dimensions */
- #define GRID_SIZE       4
+ /* Grid dimensions: the board size is picked at runtime in this range */
+ #define GRID_MIN        3
+ #define GRID_MAX        8
  #define CELL_MARGIN     5   /* px between cells */
  
  /*
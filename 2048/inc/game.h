@@ -10,35 +10,162 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Storage class of the game state below.
+ *
+ * Empty in the firmware. Host tools that play games on several threads at
+ * once (tools/sim2048.c) build with -DGAME_TLS=_Thread_local.
+ */
+#ifndef GAME_TLS
+#define GAME_TLS
+#endif
+
+/**
+ * @brief Move directions, numbered as the input callbacks report them.
+ */
+enum move_dir {
+    MOVE_NONE  = 0,
+    MOVE_LEFT  = 1,
+    MOVE_UP    = 2,
+    MOVE_RIGHT = 3,
+    MOVE_DOWN  = 4,
+};
 
 /**
  * @brief The current board state.
  *
- * A 4×4 array where 0 represents an empty cell, and any other value
- * represents a tile of that value.
+ * The top-left grid_size × grid_size cells are in play: 0 represents an
+ * empty cell, and any other value represents a tile of that value. Cells
+ * outside the board stay 0.
+ */
+extern GAME_TLS int grid[GRID_MAX][GRID_MAX];
+
+/**
+ * @brief Rows (and columns) of the board in play, GRID_MIN..GRID_MAX.
+ *
+ * Change it with set_grid_size().
+ */
+extern GAME_TLS int grid_size;
+
+/** Flat index of cell (r, c), as used in struct tile_delta. */
+#define CELL_INDEX(r, c) ((r) * GRID_MAX + (c))
+
+/** Bit of cell (r, c) in grid_occupied. */
+#define CELL_BIT(r, c) (1ULL << CELL_INDEX(r, c))
+
+/**
+ * @brief Occupancy of grid[][]: CELL_BIT(r, c) is set iff grid[r][c] != 0.
+ *
+ * Kept up to date by the move functions, spawn_tile() and init_game(), so
+ * spawning and the game-over check never scan for empty cells. Call
+ * grid_changed() after writing grid[][] any other way.
  */
-extern int grid[GRID_SIZE][GRID_SIZE];
+extern GAME_TLS uint64_t grid_occupied;
+
+/** Score: the sum of every tile created by a merge this game. */
+extern GAME_TLS uint32_t game_score;
+
+/**
+ * @brief State of the game's xorshift32 spawn generator.
+ *
+ * Seeded from the system RNG by init_game(). Saving and restoring it with
+ * the board (see history.h) replays the same spawns after an undo.
+ */
+extern GAME_TLS uint32_t game_rng_state;
+
+/**
+ * @brief Kind of tile event recorded in a struct tile_delta.
+ */
+enum tile_delta_type {
+    DELTA_SLIDE = 0, /**< Tile moved from @c from to the empty cell @c to. */
+    DELTA_MERGE = 1, /**< Tile moved from @c from into the equal tile at @c to. */
+    DELTA_SPAWN = 2, /**< New tile appeared at @c to (@c from == @c to). */
+};
+
+/**
+ * @brief One tile event of a move, 4 bytes.
+ *
+ * Cells are numbered CELL_INDEX(r, c). For slides and merges @c exp is the
+ * exponent of the moving tile before it merges; the resulting value is in
+ * grid[][]. For spawns it is the exponent of the new tile.
+ */
+struct tile_delta {
+    uint8_t type; /**< enum tile_delta_type. */
+    uint8_t from; /**< Source cell. */
+    uint8_t to;   /**< Destination cell. */
+    uint8_t exp;  /**< Tile exponent (value = 1 << exp). */
+};
+
+/** Longest event list: every tile moves, then one tile spawns. */
+#define MAX_TILE_DELTAS (GRID_MAX * GRID_MAX + 1)
+
+/**
+ * @brief Tile events of one move, in the order they were applied.
+ */
+struct move_deltas {
+    uint8_t count;
+    struct tile_delta d[MAX_TILE_DELTAS];
+};
+
+/**
+ * @brief Events of the last move plus the spawns that followed it.
+ *
+ * Reset by init_game() and every move; stationary tiles are not listed.
+ * Lets the UI animate a move instead of only repainting the final grid.
+ */
+extern GAME_TLS struct move_deltas last_deltas;
+
+/**
+ * @brief Select the board size for the next init_game().
+ *
+ * Also selects the move kernel specialized for that size.
+ *
+ * @param n Rows and columns, GRID_MIN..GRID_MAX.
+ * @return false if @p n is out of range (the size is unchanged).
+ */
+bool set_grid_size(int n);
+
+/**
+ * @brief Recompute grid_occupied after grid[][] was written directly.
+ */
+void grid_changed(void);
 
 /**
  * @brief Reset the board and spawn two initial tiles.
  *
- * Clears the grid to all zeros and then randomly places two tiles
- * (2 or, with 10% chance, 4) on empty cells.
+ * Clears the grid and score to zero, reseeds game_rng_state, and then randomly
+ * places two tiles (2 or, with 10% chance, 4) on empty cells.
  */
 void init_game(void);
 
 /**
  * @brief Add one new tile (2 or 4) at a random empty position.
  *
- * Chooses a random empty cell and places a 2 (90% chance) or 4 (10% chance).
+ * Chooses a random empty cell by popcount / select on grid_occupied and
+ * places a 2 (90% chance) or 4 (10% chance), appending a DELTA_SPAWN event
+ * to last_deltas.
  */
 void spawn_tile(void);
 
+/**
+ * @brief Shift and merge every row or column toward one edge.
+ *
+ * Compresses non-zero tiles toward the edge, merges equal adjacent tiles
+ * into one tile of double value (each tile merges at most once), and
+ * records every slide and merge in last_deltas; merged values are added to
+ * game_score. Runs the kernel selected by set_grid_size().
+ *
+ * @param dir Direction to move (MOVE_LEFT … MOVE_DOWN).
+ * @return true if any tile moved or merged, false otherwise.
+ */
+bool move_tiles(enum move_dir dir);
+
 /**
  * @brief Shift and merge all rows to the left.
  *
- * Compresses non-zero tiles leftward, merges equal adjacent tiles into one
- * tile of double value, and compresses again.
+ * Same as move_tiles(MOVE_LEFT).
  *
  * @return true if any tile moved or merged, false otherwise.
  */
@@ -47,8 +174,7 @@ bool move_left(void);
 /**
  * @brief Shift and merge all rows to the right.
  *
- * Mirrors the move_left algorithm: reverses each row, applies move_left,
- * then reverses back.
+ * Same as move_tiles(MOVE_RIGHT).
  *
  * @return true if any tile moved or merged, false otherwise.
  */
@@ -57,7 +183,7 @@ bool move_right(void);
 /**
  * @brief Shift and merge all columns upward.
  *
- * Transposes the grid, applies move_left, then transposes back.
+ * Same as move_tiles(MOVE_UP).
  *
  * @return true if any tile moved or merged, false otherwise.
  */
@@ -66,7 +192,7 @@ bool move_up(void);
 /**
  * @brief Shift and merge all columns downward.
  *
- * Transposes the grid, applies move_right, then transposes back.
+ * Same as move_tiles(MOVE_DOWN).
  *
  * @return true if any tile moved or merged, false otherwise.
  */
@@ -75,8 +201,8 @@ bool move_down(void);
 /**
  * @brief Check if any move is possible.
  *
- * Scans for any empty cell (value 0) or any pair of equal adjacent tiles
- * horizontally or vertically.
+ * True while grid_occupied shows an empty cell; a full board is scanned
+ * for any pair of equal adjacent tiles horizontally or vertically.
  *
  * @return true if at least one move remains possible, false if the game is over.
  */
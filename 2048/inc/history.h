@@ -0,0 +1,57 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+/**
+ * @file history.h
+ * @brief Undo / redo history for the Zephyr‑2048 project.
+ *
+ * A byte ring of at least CONFIG_2048_UNDO_DEPTH board states in static
+ * RAM. Each state stores the grid_size² tile exponents packed 5 bits each,
+ * plus game_score and game_rng_state, so an undone move spawns the same
+ * tile when it is replayed. A 4×4 state takes 18 bytes instead of the
+ * 64-byte grid[][], and smaller boards fit more states in the ring.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Bytes of one packed state: 5 bits per cell, then game_score and game_rng_state. */
+#define HISTORY_ENTRY_SIZE(n) (((n) * (n) * 5 + 7) / 8 + 8)
+
+/**
+ * @brief Forget every state and record the current game as the first one.
+ *
+ * Call after init_game(), which also makes a new board size take effect.
+ */
+void history_reset(void);
+
+/**
+ * @brief Record the current game after a move.
+ *
+ * Drops the redo states and, once the ring is full, the oldest state.
+ */
+void history_push(void);
+
+/**
+ * @brief Restore the state before the current one.
+ *
+ * Writes grid[][], game_score and game_rng_state; call update_ui() afterwards, which
+ * repaints only the cells that differ.
+ *
+ * @return false if there is nothing to undo.
+ */
+bool history_undo(void);
+
+/**
+ * @brief Restore the state undone last.
+ *
+ * @return false if there is nothing to redo.
+ */
+bool history_redo(void);
+
+/**
+ * @brief Static RAM used by the history ring, in bytes.
+ */
+size_t history_ram(void);
+
+#endif /* HISTORY_H */
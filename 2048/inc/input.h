@@ -17,19 +17,86 @@
   *     lv_obj_add_event_cb(scr, gesture_event_cb, LV_EVENT_GESTURE, NULL);
   *
   * It reads the last gesture direction from the active input device
-  * and sets the internal direction_flag (1=left,2=up,3=right,4=down).
+  * and queues the matching move, stamped with the last touch-down time.
   *
   * @param e Pointer to the LVGL event containing gesture information.
   */
  void gesture_event_cb(lv_event_t *e);
  
+ /**
+  * @brief LVGL press event callback recording the touch-down time.
+  *
+  * Attach it for LV_EVENT_PRESSED next to gesture_event_cb(), so the
+  * latency of a swipe is measured from the moment the finger touched.
+  */
+ void press_event_cb(lv_event_t *e);
+ 
+ #ifdef CONFIG_2048_SWIPE
+ 
+ /**
+  * @brief Swipe recognizer fed with every pointer sample.
+  *
+  * Attach this to the active screen instead of gesture_event_cb():
+  *     lv_obj_add_event_cb(scr, swipe_event_cb, LV_EVENT_ALL, NULL);
+  *
+  * Runs each pressed / pressing / released sample through swipe_feed()
+  * (see swipe.h) with the CONFIG_2048_SWIPE_* thresholds and queues the
+  * move as soon as the stroke commits, usually before the finger lifts.
+  */
+ void swipe_event_cb(lv_event_t *e);
+ 
+ #endif /* CONFIG_2048_SWIPE */
+ 
+ #ifdef CONFIG_2048_INPUT_WAKEUP
+ 
+ /**
+  * @brief Feed touch data that arrived since the last call to LVGL.
+  *
+  * An input callback wakes main() from move_queue_wait() on every input
+  * event; main() then calls this to run LVGL's input processing at once,
+  * so gestures are recognised without waiting for the indev timer.
+  */
+ void input_poll(void);
+ 
+ #endif /* CONFIG_2048_INPUT_WAKEUP */
+ 
+ #ifdef CONFIG_2048_AI
+ 
+ /**
+  * @brief LVGL long-press event callback requesting an AI search.
+  *
+  * Attach this to the active screen with:
+  *     lv_obj_add_event_cb(scr, long_press_event_cb, LV_EVENT_LONG_PRESSED, NULL);
+  *
+  * It sets the internal ai_request_flag, which main() turns into a hint or
+  * an autoplay toggle depending on CONFIG_2048_AI_MODE.
+  *
+  * @param e Pointer to the LVGL event.
+  */
+ void long_press_event_cb(lv_event_t *e);
+ 
+ #endif /* CONFIG_2048_AI */
+ 
+ #if CONFIG_2048_UNDO_DEPTH > 0
+ 
+ /**
+  * @brief Create the undo (top-left) and redo (top-right) corner buttons.
+  *
+  * A press queues CMD_UNDO / CMD_REDO behind any pending moves.
+  *
+  * @param parent LVGL parent object (typically lv_scr_act()).
+  */
+ void create_history_buttons(lv_obj_t *parent);
+ 
+ #endif /* CONFIG_2048_UNDO_DEPTH > 0 */
+ 
  #ifdef CONFIG_2048_USE_BUTTONS_TO_MOVE
  
  /**
   * @brief Create transparent edge buttons for tap-based movement.
   *
   * Each button spans one side of the board (overlapping it by BTN_OVERLAP)
-  * and uses an LV_SYMBOL_* arrow. Touching a button sets the move direction.
+  * and uses an LV_SYMBOL_* arrow. Touching a button queues the move.
   *
   * @param parent LVGL parent object (typically lv_scr_act()) to which buttons are added.
   */
@@ -0,0 +1,81 @@
+#ifndef MOVE_QUEUE_H
+#define MOVE_QUEUE_H
+
+/**
+ * @file move_queue.h
+ * @brief Bounded lock-free queue of move commands for the main loop.
+ *
+ * Single producer / single consumer ring: input callbacks (or the autoplay
+ * search) push moves, main() pops them in order. Every push also wakes
+ * main() from move_queue_wait(), so a move is applied as soon as it is
+ * recognised instead of at the next polling tick.
+ */
+
+#include "game.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Commands queued in order with the moves, numbered after enum move_dir.
+ */
+enum queue_cmd {
+    CMD_UNDO = 8,
+    CMD_REDO = 9,
+};
+
+/**
+ * @brief One queued move or command.
+ */
+struct move_cmd {
+    uint8_t  dir;   /**< enum move_dir or enum queue_cmd. */
+    uint32_t t_cyc; /**< Cycle counter when the move's input began. */
+};
+
+/**
+ * @brief Queue a move (or command) and wake the main loop.
+ *
+ * Safe to call from one producer context (thread or ISR) concurrently
+ * with the consumer.
+ *
+ * @param dir Direction to move (MOVE_LEFT … MOVE_DOWN), or CMD_UNDO / CMD_REDO.
+ * @return false if the queue was full and the move was dropped.
+ */
+bool move_queue_put(int dir);
+
+/**
+ * @brief Like move_queue_put(), but stamped with the cycle count @p t_cyc
+ *        at which the input began (e.g. touch-down of a swipe).
+ */
+bool move_queue_put_at(int dir, uint32_t t_cyc);
+
+/**
+ * @brief Take the oldest queued move.
+ *
+ * @param cmd Output for the move.
+ * @return false if the queue is empty.
+ */
+bool move_queue_get(struct move_cmd *cmd);
+
+/**
+ * @brief Check whether no move is queued.
+ */
+bool move_queue_empty(void);
+
+/**
+ * @brief Wake a pending move_queue_wait() without queuing a move.
+ */
+void move_queue_wake(void);
+
+/**
+ * @brief Sleep until a move is queued, move_queue_wake() is called, or
+ *        @p timeout expires. Returns at once if a move is already queued.
+ */
+void move_queue_wait(k_timeout_t timeout);
+
+/**
+ * @brief Number of moves dropped because the queue was full.
+ */
+uint32_t move_queue_dropped(void);
+
+#endif /* MOVE_QUEUE_H */
@@ -0,0 +1,110 @@
+#ifndef NTUPLE_H
+#define NTUPLE_H
+
+/**
+ * @file ntuple.h
+ * @brief Learned N-tuple position evaluator for the Zephyr‑2048 project.
+ *
+ * An N-tuple network scores a board by looking up each tuple of cells (in
+ * all eight board symmetries) in a weight table and summing the weights.
+ * The weights are trained on the host by tools/ntuple_train.c and shipped
+ * as a flash-resident blob: a struct ntuple_header followed by int16_t
+ * fixed-point weights, read in place without copying.
+ */
+
+#include "bitboard.h"
+#include "game.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** Blob magic, "NT2K" in little-endian byte order. */
+#define NTUPLE_MAGIC       0x4B32544EU
+/** Blob format version. */
+#define NTUPLE_VERSION     1
+/** Most tuples a network may have. */
+#define NTUPLE_MAX_TUPLES  8
+/** Most cells per tuple. */
+#define NTUPLE_MAX_LEN     6
+
+/**
+ * @brief Blob header, stored little-endian at the start of the weight blob.
+ *
+ * Followed by n_tuples tables of alphabet^tuple_len int16_t weights each.
+ * Exponents at or above alphabet-1 are clamped to alphabet-1, so a smaller
+ * alphabet trades strength on huge tiles for a smaller table.
+ */
+struct ntuple_header {
+    uint32_t magic;       /**< NTUPLE_MAGIC. */
+    uint8_t  version;     /**< NTUPLE_VERSION. */
+    uint8_t  n_tuples;    /**< Number of tuples (1..NTUPLE_MAX_TUPLES). */
+    uint8_t  tuple_len;   /**< Cells per tuple (1..NTUPLE_MAX_LEN). */
+    uint8_t  alphabet;    /**< Distinct exponents per cell (2..16). */
+    int8_t   shift;       /**< Real weight = stored weight * 2^shift. */
+    uint8_t  reserved[3];
+    /** Cell indices (r*4 + c) of each tuple in its base orientation. */
+    uint8_t  cells[NTUPLE_MAX_TUPLES][NTUPLE_MAX_LEN];
+    uint8_t  pad[4];
+};
+
+/**
+ * @brief A loaded network: points into the blob, plus the symmetric cell lists.
+ */
+struct ntuple_net {
+    const struct ntuple_header *hdr;
+    const int16_t *weights;
+    uint32_t table_size;  /**< Entries per tuple table (alphabet^tuple_len). */
+    /** Shift of each tuple cell's nibble, for each of the eight symmetries. */
+    uint8_t  shifts[NTUPLE_MAX_TUPLES][8][NTUPLE_MAX_LEN];
+};
+
+/**
+ * @brief Validate a weight blob and prepare a network that reads it in place.
+ *
+ * @param blob Pointer to the blob (must stay valid and be 2-byte aligned).
+ * @param size Size of the blob in bytes.
+ * @param net  Network to fill in.
+ * @return 0 on success, -1 if the blob is malformed.
+ */
+int ntuple_load(const void *blob, size_t size, struct ntuple_net *net);
+
+/**
+ * @brief Compute the position value of an afterstate.
+ *
+ * @return Expected future score from @p b, in points.
+ */
+int32_t ntuple_eval(const struct ntuple_net *net, bb_board_t b);
+
+/**
+ * @brief Tuple table index of tuple @p t in symmetry @p s of board @p b.
+ *
+ * Exposed for the host trainer, which updates the same entries it reads.
+ */
+static inline uint32_t ntuple_index(const struct ntuple_net *net, int t, int s, bb_board_t b)
+{
+    uint32_t idx = 0;
+    uint32_t top = net->hdr->alphabet - 1;
+
+    for (int i = 0; i < net->hdr->tuple_len; i++) {
+        uint32_t e = (uint32_t)(b >> net->shifts[t][s][i]) & 0xF;
+        idx = idx * net->hdr->alphabet + (e < top ? e : top);
+    }
+    return idx;
+}
+
+/**
+ * @brief Pick the move with the best reward plus afterstate value (1-ply greedy).
+ *
+ * @return The best move, or MOVE_NONE if no move is possible.
+ */
+enum move_dir ntuple_best_move(const struct ntuple_net *net, bb_board_t b);
+
+#ifdef CONFIG_2048_AI_NTUPLE
+
+/** Weight blob built into flash from data/ntuple_weights.bin. */
+extern const uint8_t ntuple_weights[];
+/** Size of ntuple_weights in bytes. */
+extern const size_t ntuple_weights_size;
+
+#endif /* CONFIG_2048_AI_NTUPLE */
+
+#endif /* NTUPLE_H */
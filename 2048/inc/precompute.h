@@ -0,0 +1,53 @@
+#ifndef PRECOMPUTE_H
+#define PRECOMPUTE_H
+
+/**
+ * @file precompute.h
+ * @brief Speculative next-move results for the Zephyr‑2048 project.
+ *
+ * While the main loop is idle, each of the four moves is played on a copy
+ * of the game, including its spawn (game_rng_state makes it deterministic), the
+ * game-over check and the set of cells that change. A swipe then commits
+ * the ready result instead of running the engine.
+ */
+
+#include "game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Forget the results; call whenever the game state changes other
+ *        than through precompute_commit().
+ */
+void precompute_invalidate(void);
+
+/**
+ * @brief Compute the four results if they are not ready.
+ *
+ * Leaves the game state unchanged.
+ */
+void precompute_run(void);
+
+/**
+ * @brief Moves that may change the board, as a mask of 1 << dir.
+ *
+ * @return The moves that change the board, or every move if the results
+ *         are not ready.
+ */
+uint8_t precompute_valid_moves(void);
+
+/**
+ * @brief Make the precomputed result of @p dir the current game.
+ *
+ * Writes grid[][], grid_occupied, game_score, game_rng_state and last_deltas as
+ * move_tiles() followed by spawn_tile() would.
+ *
+ * @param dir     Move to commit.
+ * @param changed Output: CELL_BIT mask of the cells whose value changed.
+ * @param over    Output: true if no move is possible afterwards.
+ * @return false if the results are not ready or @p dir moves nothing
+ *         (nothing is written then).
+ */
+bool precompute_commit(enum move_dir dir, uint64_t *changed, bool *over);
+
+#endif /* PRECOMPUTE_H */
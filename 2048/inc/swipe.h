@@ -0,0 +1,71 @@
+#ifndef SWIPE_H
+#define SWIPE_H
+
+/**
+ * @file swipe.h
+ * @brief Touch-sample swipe recognizer for the Zephyr‑2048 project.
+ *
+ * Classifies a stroke from its touch samples as they arrive and commits a
+ * direction as soon as the stroke is long or fast enough, usually before
+ * the finger lifts. A stroke whose major axis does not dominate the minor
+ * one by the configured ratio is not committed, so a diagonal swipe moves
+ * nothing instead of picking an arbitrary side.
+ *
+ * Pure logic with no Zephyr or LVGL calls: the firmware feeds it LVGL
+ * pointer samples, tools/swipe_replay.c feeds it recorded traces.
+ */
+
+#include "game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Recognizer thresholds.
+ */
+struct swipe_params {
+    uint16_t commit_px;      /**< Commit once the stroke is this long. */
+    uint16_t min_px;         /**< Shortest stroke that may commit at all. */
+    uint16_t min_speed;      /**< Commit a stroke of min_px or more early at
+                                  this average speed, in px/s. */
+    uint16_t axis_ratio_pct; /**< Major axis must be this % of the minor. */
+};
+
+/**
+ * @brief Touch sample kinds fed to swipe_feed().
+ */
+enum swipe_phase {
+    SWIPE_DOWN, /**< Finger touched: starts a stroke. */
+    SWIPE_MOVE, /**< Finger still down. */
+    SWIPE_UP,   /**< Finger lifted: last chance to commit. */
+};
+
+/**
+ * @brief Recognizer state for one pointer.
+ */
+struct swipe {
+    struct swipe_params p;
+    bool     active;    /**< A stroke is in progress and has not committed. */
+    int32_t  x0, y0;    /**< Touch-down point. */
+    uint32_t t0_us;     /**< Touch-down time. */
+};
+
+/**
+ * @brief Reset a recognizer and set its thresholds.
+ */
+void swipe_init(struct swipe *s, const struct swipe_params *p);
+
+/**
+ * @brief Feed one touch sample.
+ *
+ * @param s     Recognizer.
+ * @param phase Kind of sample.
+ * @param x     Pointer x in px.
+ * @param y     Pointer y in px (growing downward).
+ * @param t_us  Sample time in microseconds (may wrap).
+ * @return The direction committed by this sample, or MOVE_NONE. A stroke
+ *         commits at most once.
+ */
+enum move_dir swipe_feed(struct swipe *s, enum swipe_phase phase,
+                         int32_t x, int32_t y, uint32_t t_us);
+
+#endif /* SWIPE_H */
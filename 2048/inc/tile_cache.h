@@ -0,0 +1,56 @@
+#ifndef TILE_CACHE_H
+#define TILE_CACHE_H
+
+/**
+ * @file tile_cache.h
+ * @brief Pre-rendered tile bitmaps for the Zephyr‑2048 project.
+ *
+ * Each tile value is rendered once (rounded background plus number) into
+ * a slot of a static pixel pool with lv_snapshot, and board cells become
+ * lv_image objects that blit the slot. Slots in use by a cell are pinned;
+ * a value that finds no free slot is drawn the classic way by the caller.
+ */
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/**
+ * @brief Drop every cached tile and size the slots for a new board.
+ *
+ * @param board Board object, for its background color.
+ * @param w     Cell width in px.
+ * @param h     Cell height in px.
+ */
+void tile_cache_init(lv_obj_t *board, int w, int h);
+
+/**
+ * @brief Get the bitmap of tile value @p v and pin it.
+ *
+ * Renders the tile into the least recently used free slot on a miss.
+ *
+ * @return The bitmap (usable as an lv_image source), or NULL if every
+ *         slot is pinned by another value.
+ */
+const lv_draw_buf_t *tile_cache_acquire(int v);
+
+/**
+ * @brief Unpin a bitmap returned by tile_cache_acquire() for value @p v.
+ */
+void tile_cache_release(int v);
+
+/**
+ * @brief Hit / miss / render counters since tile_cache_init().
+ */
+struct tile_cache_stats {
+    uint16_t slots;     /**< Slots that fit the pool at this cell size. */
+    uint32_t hits;
+    uint32_t renders;   /**< Misses rendered into a slot. */
+    uint32_t fallbacks; /**< Misses with every slot pinned. */
+};
+
+/**
+ * @brief Read the counters.
+ */
+void tile_cache_get_stats(struct tile_cache_stats *st);
+
+#endif /* TILE_CACHE_H */
@@ -8,6 +8,7 @@
  #define UI_H
  
  #include "config.h"
+ #include "game.h"
  #include <lvgl.h>
  
  /**
@@ -33,25 +34,102 @@
  lv_color_t get_text_color(int v);
  
  /**
-  * @brief Create and lay out the 4×4 grid of cells.
+  * @brief Create and lay out the grid_size × grid_size grid of cells.
   *
   * Allocates a parent “board” object (centered and scaled by BOARD_SCALE)
-  * then creates GRID_SIZE × GRID_SIZE child cells with margins of CELL_MARGIN.
-  * Each cell holds an empty label initially.
+  * then creates grid_size × grid_size child cells with margins of CELL_MARGIN.
+  * Each cell holds an empty label initially; boards with short cells use a
+  * smaller font. The first call also builds one shared lv_style_t per tile
+  * exponent from get_bg_color()/get_text_color().
   *
   * @param parent The LVGL object (e.g. lv_scr_act()) to attach the board to.
   */
  void create_board(lv_obj_t *parent);
  
  /**
-  * @brief Refresh all cell labels and backgrounds from the game state.
+  * @brief Delete the board created by create_board() and all its children.
   *
-  * Reads the global `grid[GRID_SIZE][GRID_SIZE]` array and for each cell:
-  *  - Sets its background color via get_bg_color()
+  * Call anim_cancel() first so no animation targets a deleted cell.
+  */
+ void destroy_board(void);
+ 
+ /**
+  * @brief Show a title and one button per board size (GRID_MIN..GRID_MAX).
+  *
+  * A button press stores its size in the size_request global (defined in
+  * main.c) and wakes the main loop, which starts a new game of that size.
+  *
+  * @param parent Parent object, usually lv_scr_act().
+  * @param title  Text above the buttons (copied).
+  */
+ void create_size_menu(lv_obj_t *parent, const char *title);
+ 
+ /**
+  * @brief Remove the menu shown by create_size_menu(), if any.
+  */
+ void destroy_size_menu(void);
+ 
+ /**
+  * @brief Refresh changed cell labels and backgrounds from the game state.
+  *
+  * Reads the grid_size × grid_size cells of the global `grid` array and, for each cell
+  * whose value differs from the last call (every cell with
+  * CONFIG_2048_UI_DIFF disabled):
+  *  - Swaps in the shared tile style (background and inherited text color)
   *  - Sets its label text to the tile value (or empty)
-  *  - Sets its label text color via get_text_color()
   */
  void update_ui(void);
  
+ /**
+  * @brief Like update_ui(), but only for the cells in @p mask.
+  *
+  * @param mask CELL_BIT() of each cell to refresh; other cells are not read.
+  *             Bits outside the board are ignored, so UINT64_MAX works
+  *             like update_ui().
+  */
+ void update_cells(uint64_t mask);
+ 
+ /**
+  * @brief Create a tile object showing value 0.
+  *
+  * A tile is a cell object with the shared cell and tile styles and one
+  * centered label child. The board cells and the animation ghosts use it.
+  *
+  * @param parent Parent object.
+  * @param w      Width in px.
+  * @param h      Height in px.
+  * @return The new tile.
+  */
+ lv_obj_t *create_tile(lv_obj_t *parent, int w, int h);
+ 
+ /**
+  * @brief Show value @p v (0 = empty) on a tile created by create_tile().
+  */
+ void set_tile_value(lv_obj_t *tile, int v);
+ 
+ /**
+  * @brief Get the board tile at row @p r, column @p c.
+  */
+ lv_obj_t *get_cell(int r, int c);
+ 
+ /**
+  * @brief Show value @p v in the board cell at (@p r, @p c).
+  *
+  * Like update_ui() for a single cell, without reading grid[][]: lets the
+  * animation layer show a cell empty until a sliding tile arrives.
+  */
+ void paint_cell(int r, int c, int v);
+ 
+ #ifdef CONFIG_2048_AI
+ 
+ /**
+  * @brief Show an arrow for the suggested move over the board.
+  *
+  * @param dir Move to suggest, or MOVE_NONE to hide the arrow.
+  */
+ void show_hint(enum move_dir dir);
+ 
+ #endif /* CONFIG_2048_AI */
+ 
  #endif /* UI_H */
  
\ No newline at end of file
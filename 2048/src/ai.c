@@ -0,0 +1,295 @@
+/* src/ai.c
+ *
+ * Implements the expectimax hint / autoplay search on the packed bitboard:
+ * heuristic or learned N-tuple evaluation, transposition table, and
+ * iterative deepening under a hard per-move time budget.
+ */
+
+ #include "config.h"
+ #include "ai.h"
+ #include "bitboard.h"
+ #include "ntuple.h"
+ #include <math.h>
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include <zephyr/kernel.h>
+
+ #ifdef CONFIG_2048_AI
+
+ /* Chance branches less likely than this are evaluated, not expanded */
+ #define PROB_CUTOFF      0.0001f
+ /* Nodes between two reads of the cycle counter */
+ #define DEADLINE_STRIDE  256
+
+ /* Heuristic weights (per row and per column) */
+ #define W_BASE           200000.0f
+ #define W_EMPTY          270.0f
+ #define W_MERGE          700.0f
+ #define W_MONOTONIC      47.0f
+ #define W_SUM            11.0f
+
+ /* e^3.5 per tile: penalizes boards that hold many large tiles */
+ static const float exp_pow35[16] = {
+     0.0f, 1.0f, 11.3f, 46.8f, 128.0f, 279.5f, 529.1f, 907.5f,
+     1448.2f, 2187.0f, 3162.3f, 4414.4f, 5986.0f, 7921.4f, 10267.1f, 13071.3f,
+ };
+
+ /* One transposition table slot: value of a chance node at a given depth */
+ struct tt_entry {
+     bb_board_t board;
+     float      value;
+     uint8_t    depth;
+     uint8_t    gen;
+ };
+
+ #define TT_SIZE (1u << CONFIG_2048_AI_TT_BITS)
+
+ static struct tt_entry tt[TT_SIZE];
+ static uint8_t tt_gen;
+
+ #ifdef CONFIG_2048_AI_NTUPLE
+ /* Learned evaluator, read in place from the flash blob */
+ static struct ntuple_net net;
+ static bool net_ready;
+ #endif
+ 
+ /* Per-search state */
+ static uint32_t nodes;
+ static uint32_t start_cyc;
+ static uint32_t budget_cyc;
+ static bool     aborted;
+
+ static inline uint32_t tt_index(bb_board_t b)
+ {
+     return (uint32_t)((b * 0x9E3779B97F4A7C15ULL) >> (64 - CONFIG_2048_AI_TT_BITS));
+ }
+
+ /* Score one row (or column, after a transpose) of four exponents */
+ static float eval_row(uint16_t row)
+ {
+     int e[4];
+     int empty = 0, merges = 0, prev = 0, run = 0;
+     float sum = 0.0f, mono_l = 0.0f, mono_r = 0.0f;
+
+     for (int i = 0; i < 4; i++) {
+         e[i] = (row >> (4 * i)) & 0xF;
+         sum += exp_pow35[e[i]];
+         if (e[i] == 0) {
+             empty++;
+             continue;
+         }
+         if (e[i] == prev) {
+             run++;
+         } else if (run > 0) {
+             merges += 1 + run;
+             run = 0;
+         }
+         prev = e[i];
+     }
+     if (run > 0) {
+         merges += 1 + run;
+     }
+
+     for (int i = 1; i < 4; i++) {
+         float a = (float)(e[i - 1] * e[i - 1]) * (float)(e[i - 1] * e[i - 1]);
+         float b = (float)(e[i] * e[i]) * (float)(e[i] * e[i]);
+         if (e[i - 1] > e[i]) {
+             mono_l += a - b;
+         } else {
+             mono_r += b - a;
+         }
+     }
+
+     return W_EMPTY * empty + W_MERGE * merges -
+            W_MONOTONIC * (mono_l < mono_r ? mono_l : mono_r) -
+            W_SUM * sum;
+ }
+
+ static float evaluate(bb_board_t b)
+ {
+ #ifdef CONFIG_2048_AI_NTUPLE
+     if (net_ready) {
+         return (float)ntuple_eval(&net, b);
+     }
+ #endif
+     bb_board_t t = bb_transpose(b);
+     float v = 2.0f * W_BASE;
+
+     for (int r = 0; r < 4; r++) {
+         v += eval_row((uint16_t)(b >> (16 * r)));
+         v += eval_row((uint16_t)(t >> (16 * r)));
+     }
+     return v;
+ }
+
+ /* Merge points of a move: the N-tuple values exclude them, the heuristic ignores them */
+ static inline float move_gain(bb_board_t before, bb_board_t after)
+ {
+ #ifdef CONFIG_2048_AI_NTUPLE
+     if (net_ready) {
+         return (float)(bb_score(after) - bb_score(before));
+     }
+ #endif
+     return 0.0f;
+ }
+ 
+ static bool out_of_time(void)
+ {
+     if (++nodes % DEADLINE_STRIDE == 0 &&
+         k_cycle_get_32() - start_cyc >= budget_cyc) {
+         aborted = true;
+     }
+     return aborted;
+ }
+
+ static float chance_node(bb_board_t b, int depth, float prob);
+
+ /* Best value over the four moves; 0 for a lost board */
+ static float max_node(bb_board_t b, int depth, float prob)
+ {
+     /* N-tuple values go negative: a legal move always beats a lost board */
+     float best = -INFINITY;
+
+     if (out_of_time()) {
+         return 0.0f;
+     }
+     for (int d = MOVE_LEFT; d <= MOVE_DOWN; d++) {
+         bb_board_t nb = bb_move(b, (enum move_dir)d);
+         if (nb == b) {
+             continue;
+         }
+         float v = move_gain(b, nb) + chance_node(nb, depth, prob);
+         if (v > best) {
+             best = v;
+         }
+     }
+     return best == -INFINITY ? 0.0f : best;
+ }
+
+ /* Expected value over every 2 (90%) / 4 (10%) spawn on an empty cell */
+ static float chance_node(bb_board_t b, int depth, float prob)
+ {
+     if (depth == 0 || prob < PROB_CUTOFF) {
+         return evaluate(b);
+     }
+     if (out_of_time()) {
+         return 0.0f;
+     }
+
+     struct tt_entry *e = &tt[tt_index(b)];
+     if (e->gen == tt_gen && e->board == b && e->depth >= depth) {
+         return e->value;
+     }
+
+     int empties = bb_count_empty(b);
+     float p2 = prob * 0.9f / empties;
+     float p4 = prob * 0.1f / empties;
+     float sum = 0.0f;
+
+     for (int i = 0; i < 16; i++) {
+         if (((b >> (4 * i)) & 0xF) != 0) {
+             continue;
+         }
+         sum += 0.9f * max_node(b | (1ULL << (4 * i)), depth - 1, p2);
+         sum += 0.1f * max_node(b | (2ULL << (4 * i)), depth - 1, p4);
+     }
+     sum /= empties;
+
+     if (!aborted) {
+         e->board = b;
+         e->value = sum;
+         e->depth = (uint8_t)depth;
+         e->gen   = tt_gen;
+     }
+     return sum;
+ }
+
+ /* One full search of the given depth; MOVE_NONE if it ran out of time */
+ static enum move_dir search_root(bb_board_t b, int depth)
+ {
+     enum move_dir best_dir = MOVE_NONE;
+     float best = -INFINITY;
+
+     for (int d = MOVE_LEFT; d <= MOVE_DOWN; d++) {
+         bb_board_t nb = bb_move(b, (enum move_dir)d);
+         if (nb == b) {
+             continue;
+         }
+         float v = move_gain(b, nb) + chance_node(nb, depth - 1, 1.0f);
+         if (aborted) {
+             return MOVE_NONE;
+         }
+         if (v > best) {
+             best = v;
+             best_dir = (enum move_dir)d;
+         }
+     }
+     return best_dir;
+ }
+
+ /**
+  * @brief Prepare the search.
+  */
+ void ai_init(void)
+ {
+     bb_init();
+ #ifdef CONFIG_2048_AI_NTUPLE
+     net_ready = (ntuple_load(ntuple_weights, ntuple_weights_size, &net) == 0);
+     if (!net_ready) {
+         printk("ai: invalid N-tuple blob, using the heuristic\n");
+     }
+ #endif
+ }
+
+ /**
+  * @brief Pick the best move for a board within a time budget.
+  */
+ enum move_dir ai_best_move(bb_board_t b, uint32_t budget_ms, struct ai_stats *stats)
+ {
+     enum move_dir best = MOVE_NONE;
+     int depth_done = 0;
+
+     nodes = 0;
+     aborted = false;
+     start_cyc = k_cycle_get_32();
+     budget_cyc = k_ms_to_cyc_ceil32(budget_ms);
+
+     /* A new generation invalidates every slot without clearing the table */
+     if (++tt_gen == 0) {
+         for (uint32_t i = 0; i < TT_SIZE; i++) {
+             tt[i].gen = 0;
+         }
+         tt_gen = 1;
+     }
+
+     for (int depth = 1; depth <= CONFIG_2048_AI_MAX_DEPTH; depth++) {
+         enum move_dir dir = search_root(b, depth);
+         if (aborted) {
+             break;
+         }
+         if (dir == MOVE_NONE) {
+             /* No legal move at all */
+             break;
+         }
+         best = dir;
+         depth_done = depth;
+     }
+
+     /* Out of time before depth 1 finished: fall back to any legal move */
+     if (best == MOVE_NONE && bb_can_move(b)) {
+         for (int d = MOVE_LEFT; d <= MOVE_DOWN && best == MOVE_NONE; d++) {
+             if (bb_move(b, (enum move_dir)d) != b) {
+                 best = (enum move_dir)d;
+             }
+         }
+     }
+
+     if (stats) {
+         stats->nodes = nodes;
+         stats->elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start_cyc);
+         stats->depth = (uint8_t)depth_done;
+     }
+     return best;
+ }
+
+ #endif /* CONFIG_2048_AI */
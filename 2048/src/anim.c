@@ -0,0 +1,224 @@
+/* src/anim.c
+ *
+ * Slide / pop animations for the Zephyr‑2048 project:
+ * - anim_init(), anim_play(), anim_cancel()
+ *
+ * One lv_anim drives every ghost tile of a slide, so a move costs a single
+ * animation regardless of how many tiles it moves.
+ */
+
+ #include "config.h"
+ #include "anim.h"
+ #include "ui.h"
+ #include <lvgl.h>
+
+ #ifdef CONFIG_2048_ANIM
+
+ /* A pooled tile and the path it follows in the running slide */
+ struct ghost {
+     lv_obj_t *obj;
+     int32_t x0, y0;
+     int32_t dx, dy;
+ };
+
+ static struct ghost ghosts[CONFIG_2048_ANIM_POOL_SIZE];
+ /* Ghosts used by the running slide */
+ static int n_ghosts;
+ static bool sliding;
+ /* Events being animated; their cells are repainted when the slide ends */
+ static struct move_deltas play;
+
+ /* A merged or spawned cell and its resting place while it pops */
+ struct popper {
+     lv_obj_t *cell;
+     int32_t x, y, w, h;
+ };
+
+ static struct popper pops[MAX_TILE_DELTAS];
+ static int n_pops;
+
+ static lv_obj_t *cell_obj(uint8_t i)
+ {
+     return get_cell(i / GRID_MAX, i % GRID_MAX);
+ }
+
+ /* Slide progress v runs 0..256 */
+ static void slide_exec(lv_anim_t *a, int32_t v)
+ {
+     for (int i = 0; i < n_ghosts; i++) {
+         struct ghost *g = &ghosts[i];
+         lv_obj_set_pos(g->obj, g->x0 + g->dx * v / 256, g->y0 + g->dy * v / 256);
+     }
+ }
+
+ /*
+  * Pop size v runs in 1/256 of the cell. The cell is resized around its
+  * center rather than transform-scaled: a scaled cell with a label child
+  * is drawn through an ARGB8888 layer the size of the cell.
+  */
+ static void pop_exec(void *var, int32_t v)
+ {
+     struct popper *p = var;
+     int32_t w = p->w * v / 256, h = p->h * v / 256;
+
+     lv_obj_set_pos(p->cell, p->x + (p->w - w) / 2, p->y + (p->h - h) / 2);
+     lv_obj_set_size(p->cell, w, h);
+ }
+
+ /* Hide the ghosts and show the final value of every touched cell */
+ static void settle(void)
+ {
+     for (int i = 0; i < n_ghosts; i++) {
+         lv_obj_add_flag(ghosts[i].obj, LV_OBJ_FLAG_HIDDEN);
+     }
+     n_ghosts = 0;
+     sliding = false;
+
+     for (int i = 0; i < play.count; i++) {
+         uint8_t to = play.d[i].to;
+         paint_cell(to / GRID_MAX, to % GRID_MAX, grid[to / GRID_MAX][to % GRID_MAX]);
+     }
+ }
+
+ /* Merged tiles bump up and back, spawned tiles grow in */
+ static void pop(lv_obj_t *cell, bool merge)
+ {
+     struct popper *p = &pops[n_pops++];
+     lv_anim_t a;
+
+     /* the cell's own position and size, not its possibly stale coords */
+     p->cell = cell;
+     p->x = lv_obj_get_style_x(cell, LV_PART_MAIN);
+     p->y = lv_obj_get_style_y(cell, LV_PART_MAIN);
+     p->w = lv_obj_get_style_width(cell, LV_PART_MAIN);
+     p->h = lv_obj_get_style_height(cell, LV_PART_MAIN);
+
+     lv_anim_init(&a);
+     lv_anim_set_var(&a, p);
+     lv_anim_set_exec_cb(&a, pop_exec);
+     if (merge) {
+         lv_anim_set_values(&a, 256, 256 * 9 / 8);
+         lv_anim_set_duration(&a, CONFIG_2048_ANIM_POP_MS / 2);
+         lv_anim_set_playback_duration(&a, CONFIG_2048_ANIM_POP_MS / 2);
+     } else {
+         lv_anim_set_values(&a, 256 / 2, 256);
+         lv_anim_set_duration(&a, CONFIG_2048_ANIM_POP_MS);
+         lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+     }
+     lv_anim_start(&a);
+ }
+
+ static void slide_done(lv_anim_t *a)
+ {
+     settle();
+     for (int i = 0; i < play.count; i++) {
+         if (play.d[i].type != DELTA_SLIDE) {
+             pop(cell_obj(play.d[i].to), play.d[i].type == DELTA_MERGE);
+         }
+     }
+ }
+
+ /**
+  * @brief Create the ghost tile pool, hidden, on top of the board cells.
+  */
+ void anim_init(void)
+ {
+     lv_obj_t *cell = get_cell(0, 0);
+     lv_obj_t *board = lv_obj_get_parent(cell);
+
+     /* cell sizes are only known once the layout ran */
+     lv_obj_update_layout(board);
+     for (int i = 0; i < CONFIG_2048_ANIM_POOL_SIZE; i++) {
+         lv_obj_t *g = create_tile(board, lv_obj_get_width(cell), lv_obj_get_height(cell));
+         lv_obj_remove_flag(g, LV_OBJ_FLAG_CLICKABLE);
+         lv_obj_add_flag(g, LV_OBJ_FLAG_HIDDEN);
+         ghosts[i].obj = g;
+     }
+ }
+
+ /**
+  * @brief Slide ghost tiles along the move's events, then pop merges / spawns.
+  */
+ void anim_play(const struct move_deltas *md)
+ {
+     int movers = 0;
+     uint64_t blanked = 0;
+
+     anim_cancel();
+     play = *md;
+
+     for (int i = 0; i < play.count; i++) {
+         if (play.d[i].type != DELTA_SPAWN) {
+             movers++;
+         }
+     }
+     /* too many tiles for the pool: snap into place */
+     if (movers == 0 || movers > CONFIG_2048_ANIM_POOL_SIZE) {
+         slide_done(NULL);
+         return;
+     }
+
+     for (int i = 0; i < play.count; i++) {
+         const struct tile_delta *d = &play.d[i];
+         int r = d->to / GRID_MAX, c = d->to % GRID_MAX;
+
+         if (d->type == DELTA_SPAWN) {
+             paint_cell(r, c, 0);
+             continue;
+         }
+
+         lv_obj_t *src = cell_obj(d->from);
+         lv_obj_t *dst = cell_obj(d->to);
+         struct ghost *g = &ghosts[n_ghosts++];
+         g->x0 = lv_obj_get_x(src);
+         g->y0 = lv_obj_get_y(src);
+         g->dx = lv_obj_get_x(dst) - g->x0;
+         g->dy = lv_obj_get_y(dst) - g->y0;
+         set_tile_value(g->obj, 1 << d->exp);
+         lv_obj_set_pos(g->obj, g->x0, g->y0);
+         lv_obj_remove_flag(g->obj, LV_OBJ_FLAG_HIDDEN);
+
+         /*
+          * Until the ghosts arrive a slide target is empty, and a merge
+          * target shows its pre-merge tile unless that tile slides in too
+          * (its slide is always listed before the merge).
+          */
+         if (d->type == DELTA_SLIDE) {
+             paint_cell(r, c, 0);
+             blanked |= 1ULL << d->to;
+         } else if (!(blanked & (1ULL << d->to))) {
+             paint_cell(r, c, 1 << d->exp);
+         }
+     }
+
+     lv_anim_t a;
+     lv_anim_init(&a);
+     lv_anim_set_var(&a, ghosts);
+     lv_anim_set_custom_exec_cb(&a, slide_exec);
+     lv_anim_set_values(&a, 0, 256);
+     lv_anim_set_duration(&a, CONFIG_2048_ANIM_SLIDE_MS);
+     lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+     lv_anim_set_completed_cb(&a, slide_done);
+     lv_anim_start(&a);
+     sliding = true;
+ }
+
+ /**
+  * @brief Drop the running slide and pops, leaving the board as in grid[][].
+  */
+ void anim_cancel(void)
+ {
+     if (sliding) {
+         lv_anim_delete(ghosts, NULL);
+         settle();
+     }
+     for (int i = 0; i < n_pops; i++) {
+         if (lv_anim_delete(&pops[i], pop_exec)) {
+             pop_exec(&pops[i], 256);
+         }
+     }
+     n_pops = 0;
+     play.count = 0;
+ }
+
+ #endif /* CONFIG_2048_ANIM */
@@ -0,0 +1,75 @@
+/* src/bench.c
+ *
+ * On-device benchmark of the size-specialized move kernels in game.c.
+ */
+
+ #include "config.h"
+ #include "bench.h"
+ #include "game.h"
+ #include <string.h>
+ #include <zephyr/kernel.h>
+ #include <zephyr/random/random.h>
+
+ #ifdef CONFIG_2048_BENCH
+
+ /* Mid-game boards each timed move starts from */
+ #define POOL_SIZE 16
+
+ static int pool[POOL_SIZE][GRID_MAX][GRID_MAX];
+ /* Keeps the timed loops from being optimized away */
+ static volatile uint32_t sink;
+
+ /* Play random moves until the board is about half full */
+ static void fill_pool(int n)
+ {
+     for (int p = 0; p < POOL_SIZE; p++) {
+         init_game();
+         for (int i = 0; i < n * n * 4; i++) {
+             if (!can_move()) {
+                 init_game();
+             }
+             if (move_tiles((enum move_dir)(1 + sys_rand32_get() % 4))) {
+                 spawn_tile();
+             }
+         }
+         memcpy(pool[p], grid, sizeof(grid));
+     }
+ }
+
+ void bench_run(void)
+ {
+     int saved = grid_size;
+
+     for (int n = GRID_MIN; n <= GRID_MAX; n++) {
+         set_grid_size(n);
+         fill_pool(n);
+
+         uint32_t t0 = k_cycle_get_32();
+         for (uint32_t i = 0; i < CONFIG_2048_BENCH_MOVES; i++) {
+             memcpy(grid, pool[i % POOL_SIZE], sizeof(grid));
+             grid_changed();
+             sink += move_tiles((enum move_dir)(1 + i % 4));
+         }
+         uint32_t t1 = k_cycle_get_32();
+         /* same loop without the move */
+         for (uint32_t i = 0; i < CONFIG_2048_BENCH_MOVES; i++) {
+             memcpy(grid, pool[i % POOL_SIZE], sizeof(grid));
+             grid_changed();
+             sink += (uint32_t)grid[0][i % 4];
+         }
+         uint32_t t2 = k_cycle_get_32();
+
+         uint32_t cyc = (t1 - t0) - MIN(t1 - t0, t2 - t1);
+         uint32_t us = k_cyc_to_us_floor32(cyc);
+         printk("bench: %dx%d %u moves in %u us, %u ns/move, %u moves/s\n",
+                n, n, CONFIG_2048_BENCH_MOVES, us,
+                (uint32_t)((uint64_t)us * 1000U / CONFIG_2048_BENCH_MOVES),
+                us ? (uint32_t)((uint64_t)CONFIG_2048_BENCH_MOVES * 1000000U / us) : 0);
+     }
+
+     set_grid_size(saved);
+     memset(grid, 0, sizeof(grid));
+     grid_changed();
+ }
+
+ #endif /* CONFIG_2048_BENCH */
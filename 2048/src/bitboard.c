@@ -0,0 +1,215 @@
+/* src/bitboard.c
+ *
+ * Implements the packed 64-bit 2048 engine:
+ * row move table, moves in all four directions, spawning, and game‑over check.
+ */
+
+ #include "config.h"
+ #include "bitboard.h"
+ #include <stdbool.h>
+ #include <stdint.h>
+
+ /*
+  * Result of moving one 16-bit row to the left, indexed by the row itself.
+  * Right moves reuse it on the nibble-reversed row, which keeps the table at
+  * 128 KB instead of 256 KB for a second one.
+  */
+ static uint16_t row_left_table[1 << 16];
+ static bool table_ready;
+
+ /* Bit 0 of every nibble: used to mask per-cell flags */
+ #define NIBBLE_LSBS 0x1111111111111111ULL
+
+ /* Reverse the four nibbles of a row */
+ static inline uint16_t reverse_row(uint16_t row)
+ {
+     return (uint16_t)((row >> 12) | ((row >> 4) & 0x00F0) |
+                       ((row << 4) & 0x0F00) | (row << 12));
+ }
+
+ /* Set bit 0 of each nibble that is zero, clear everything else */
+ static inline uint64_t zero_nibbles(uint64_t x)
+ {
+     x |= x >> 2;
+     x |= x >> 1;
+     return ~x & NIBBLE_LSBS;
+ }
+
+ /* Same compress / merge / compress rule as move_left() in game.c */
+ static uint16_t compute_row_left(uint16_t row)
+ {
+     int tmp[4] = {0};
+     int cnt = 0;
+
+     for (int c = 0; c < 4; c++) {
+         int e = (row >> (4 * c)) & 0xF;
+         if (e != 0) {
+             tmp[cnt++] = e;
+         }
+     }
+
+     for (int i = 0; i < cnt - 1; i++) {
+         if (tmp[i] && tmp[i] == tmp[i + 1] && tmp[i] < BB_MAX_EXP) {
+             tmp[i]++;
+             tmp[i + 1] = 0;
+         }
+     }
+
+     uint16_t out = 0;
+     int j = 0;
+     for (int i = 0; i < 4; i++) {
+         if (tmp[i] != 0) {
+             out |= (uint16_t)(tmp[i] << (4 * j++));
+         }
+     }
+     return out;
+ }
+
+ /**
+  * @brief Build the row move table.
+  */
+ void bb_init(void)
+ {
+     if (table_ready) {
+         return;
+     }
+     for (uint32_t row = 0; row < (1u << 16); row++) {
+         row_left_table[row] = compute_row_left((uint16_t)row);
+     }
+     table_ready = true;
+ }
+
+ /**
+  * @brief Pack the top-left 4×4 of a grid[][]-style board into a bb_board_t.
+  */
+ bb_board_t bb_from_grid(const int g[GRID_MAX][GRID_MAX])
+ {
+     bb_board_t b = 0;
+
+     for (int r = 0; r < 4; r++) {
+         for (int c = 0; c < 4; c++) {
+             unsigned int v = (unsigned int)g[r][c];
+             bb_board_t e = 0;
+             while (v > 1) {
+                 v >>= 1;
+                 e++;
+             }
+             b |= e << (4 * (r * 4 + c));
+         }
+     }
+     return b;
+ }
+
+ /**
+  * @brief Unpack a bb_board_t into the top-left 4×4 of a grid[][]-style board.
+  */
+ void bb_to_grid(bb_board_t b, int g[GRID_MAX][GRID_MAX])
+ {
+     for (int r = 0; r < 4; r++) {
+         for (int c = 0; c < 4; c++) {
+             int e = bb_get_exp(b, r, c);
+             g[r][c] = e ? (1 << e) : 0;
+         }
+     }
+ }
+
+ /**
+  * @brief Shift and merge all rows to the left.
+  */
+ bb_board_t bb_move_left(bb_board_t b)
+ {
+     return (bb_board_t)row_left_table[(uint16_t)(b)] |
+            (bb_board_t)row_left_table[(uint16_t)(b >> 16)] << 16 |
+            (bb_board_t)row_left_table[(uint16_t)(b >> 32)] << 32 |
+            (bb_board_t)row_left_table[(uint16_t)(b >> 48)] << 48;
+ }
+
+ /**
+  * @brief Shift and merge all rows to the right.
+  */
+ bb_board_t bb_move_right(bb_board_t b)
+ {
+     bb_board_t out = 0;
+
+     for (int r = 0; r < 4; r++) {
+         uint16_t row = reverse_row((uint16_t)(b >> (16 * r)));
+         out |= (bb_board_t)reverse_row(row_left_table[row]) << (16 * r);
+     }
+     return out;
+ }
+
+ /**
+  * @brief Shift and merge all columns upward.
+  */
+ bb_board_t bb_move_up(bb_board_t b)
+ {
+     return bb_transpose(bb_move_left(bb_transpose(b)));
+ }
+
+ /**
+  * @brief Shift and merge all columns downward.
+  */
+ bb_board_t bb_move_down(bb_board_t b)
+ {
+     return bb_transpose(bb_move_right(bb_transpose(b)));
+ }
+
+ /**
+  * @brief Apply the move for dir.
+  */
+ bb_board_t bb_move(bb_board_t b, enum move_dir dir)
+ {
+     switch (dir) {
+     case MOVE_LEFT:  return bb_move_left(b);
+     case MOVE_UP:    return bb_move_up(b);
+     case MOVE_RIGHT: return bb_move_right(b);
+     case MOVE_DOWN:  return bb_move_down(b);
+     default:         return b;
+     }
+ }
+
+ /**
+  * @brief Count the empty cells of a packed board.
+  */
+ int bb_count_empty(bb_board_t b)
+ {
+     return __builtin_popcountll(zero_nibbles(b));
+ }
+
+ /**
+  * @brief Check if any move is possible on a packed board.
+  */
+ bool bb_can_move(bb_board_t b)
+ {
+     if (zero_nibbles(b)) {
+         return true;
+     }
+
+     /* Equal neighbours leave a zero nibble in the XOR; mask off the last
+      * column (horizontal) and the last row (vertical). */
+     uint64_t horiz = zero_nibbles(b ^ (b >> 4))  & 0x0111011101110111ULL;
+     uint64_t vert  = zero_nibbles(b ^ (b >> 16)) & 0x0000111111111111ULL;
+
+     return (horiz | vert) != 0;
+ }
+
+ /**
+  * @brief Add one new tile (2 or 4) at a random empty position.
+  */
+ bb_board_t bb_spawn_tile(bb_board_t b, uint32_t rnd_pos, uint32_t rnd_val)
+ {
+     uint64_t empty = zero_nibbles(b);
+     int empties = __builtin_popcountll(empty);
+
+     if (empties == 0) {
+         return b;
+     }
+
+     /* Drop the lowest set bits until the chosen one is lowest */
+     for (uint32_t idx = rnd_pos % empties; idx > 0; idx--) {
+         empty &= empty - 1;
+     }
+
+     bb_board_t tile = (rnd_val % 10 == 0) ? 2 : 1;
+     return b | tile << __builtin_ctzll(empty);
+ }
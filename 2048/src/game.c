@@ -1,15 +1,94 @@
 /* src/game.c
  *
  * Implements the core 2048 game logic:
- * initialization, tile spawning, moves (left/right/up/down), and game‑over check.
+ * initialization, tile spawning, moves (left/right/up/down), and game‑over check,
+ * on a board of 3×3 up to 8×8 chosen at runtime.
  */
 
  #include "config.h"
  #include "game.h"
  #include <string.h>
  #include <zephyr/random/random.h>
+ #include <zephyr/toolchain.h>
  
- int grid[GRID_SIZE][GRID_SIZE];
+ GAME_TLS int grid[GRID_MAX][GRID_MAX];
+ GAME_TLS int grid_size = 4;
+ GAME_TLS uint64_t grid_occupied;
+ GAME_TLS uint32_t game_score;
+ GAME_TLS uint32_t game_rng_state = 1;
+ GAME_TLS struct move_deltas last_deltas;
+ 
+ /* One bit per row of the board's bitmask (and per column, shifted) */
+ #define ROW0_MASK 0xFFULL
+ #define COL0_MASK 0x0101010101010101ULL
+ 
+ /* CELL_BIT() of every cell of the grid_size × grid_size board */
+ static GAME_TLS uint64_t board_mask = 0x0F0F0F0FULL;
+ 
+ /* xorshift32 step of the game's own spawn RNG */
+ static uint32_t next_rand(void)
+ {
+     uint32_t x = game_rng_state;
+ 
+     x ^= x << 13;
+     x ^= x >> 17;
+     x ^= x << 5;
+     game_rng_state = x;
+     return x;
+ }
+ 
+ /* Fill one tile event for a tile of value v */
+ static inline void set_delta(struct tile_delta *d, uint8_t type, int from, int to, int v)
+ {
+     d->type = type;
+     d->from = (uint8_t)from;
+     d->to   = (uint8_t)to;
+     d->exp  = (uint8_t)__builtin_ctz((unsigned int)v);
+ }
+ 
+ /* Append one tile event (of a tile of value v) to last_deltas */
+ static void add_delta(uint8_t type, int from, int to, int v)
+ {
+     if (last_deltas.count < MAX_TILE_DELTAS) {
+         set_delta(&last_deltas.d[last_deltas.count++], type, from, to, v);
+     }
+ }
+ 
+ /* Index of the k-th (from 0) set bit of m; m has more than k bits set */
+ static int select_bit(uint64_t m, int k)
+ {
+     int base = 0;
+ 
+     /* skip whole board rows (bytes) first */
+     for (;;) {
+         int cnt = __builtin_popcount((unsigned int)(m & 0xFF));
+         if (k < cnt) {
+             break;
+         }
+         k -= cnt;
+         m >>= 8;
+         base += 8;
+     }
+     while (k--) {
+         m &= m - 1;
+     }
+     return base + __builtin_ctzll(m);
+ }
+ 
+ /**
+  * @brief Recompute the occupancy mask after grid[][] was written directly.
+  */
+ void grid_changed(void)
+ {
+     grid_occupied = 0;
+     for (int r = 0; r < grid_size; r++) {
+         for (int c = 0; c < grid_size; c++) {
+             if (grid[r][c] != 0) {
+                 grid_occupied |= CELL_BIT(r, c);
+             }
+         }
+     }
+ }
  
  /**
   * @brief Reset the board and spawn two initial tiles.
@@ -18,33 +97,15 @@
  {
      /* Clear grid */
      memset(grid, 0, sizeof(grid));
+     grid_occupied = 0;
+     game_score = 0;
+     last_deltas.count = 0;
+     /* xorshift never leaves the all-zero state, so keep it odd */
+     game_rng_state = sys_rand32_get() | 1U;
  
      /* Place two initial tiles */
-     for (int i = 0; i < 2; i++) {
-         int empties = 0;
-         int coords[GRID_SIZE * GRID_SIZE][2];
- 
-         /* Collect empty cell coordinates */
-         for (int r = 0; r < GRID_SIZE; r++) {
-             for (int c = 0; c < GRID_SIZE; c++) {
-                 if (grid[r][c] == 0) {
-                     coords[empties][0] = r;
-                     coords[empties][1] = c;
-                     empties++;
-                 }
-             }
-         }
- 
-         if (empties == 0) {
-             return;
-         }
- 
-         /* Pick one at random */
-         int idx = sys_rand32_get() % empties;
-         /* 90% chance 2, 10% chance 4 */
-         grid[coords[idx][0]][coords[idx][1]] =
-             (sys_rand32_get() % 10 == 0) ? 4 : 2;
-     }
+     spawn_tile();
+     spawn_tile();
  }
  
  /**
@@ -52,106 +113,155 @@
   */
  void spawn_tile(void)
  {
-     int empties = 0;
-     int coords[GRID_SIZE * GRID_SIZE][2];
- 
-     /* Collect empty cell coordinates */
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = 0; c < GRID_SIZE; c++) {
-             if (grid[r][c] == 0) {
-                 coords[empties][0] = r;
-                 coords[empties][1] = c;
-                 empties++;
-             }
-         }
-     }
+     uint64_t empty = board_mask & ~grid_occupied;
  
-     if (empties == 0) {
+     if (empty == 0) {
          return;
      }
  
      /* Pick one at random */
-     int idx = sys_rand32_get() % empties;
+     int idx = select_bit(empty, next_rand() % __builtin_popcountll(empty));
+     int r = idx / GRID_MAX, c = idx % GRID_MAX;
      /* 90% chance 2, 10% chance 4 */
-     grid[coords[idx][0]][coords[idx][1]] =
-         (sys_rand32_get() % 10 == 0) ? 4 : 2;
+     grid[r][c] = (next_rand() % 10 == 0) ? 4 : 2;
+     grid_occupied |= CELL_BIT(r, c);
+     add_delta(DELTA_SPAWN, idx, idx, grid[r][c]);
  }
  
- /**
-  * @brief Shift and merge all rows to the left.
+ /*
+  * Shift and merge the n×n board in place. Line i starts at cell
+  * first + i * stride on the destination edge and runs away from it in
+  * steps of step. Walking from the edge, a tile equal to the last placed,
+  * not yet merged tile merges into it, any other tile is placed next; every
+  * cell between the write position and the read position is already empty.
   *
-  * @return true if any tile moved or merged, false otherwise.
+  * Always inlined with a constant n, so each board size gets its own
+  * fully unrolled kernel.
   */
- bool move_left(void)
+ static ALWAYS_INLINE bool move_board(enum move_dir dir, const int n)
  {
-     bool moved = false;
+     int *cell = &grid[0][0];
+     /* a move has at most n * n events, so no bounds check is needed */
+     struct tile_delta *d = last_deltas.d;
+     uint64_t occ = grid_occupied;
+     uint32_t gain = 0;
+     int first, step, stride;
+ 
+     switch (dir) {
+     case MOVE_LEFT:  first = 0;                  step = 1;         stride = GRID_MAX; break;
+     case MOVE_RIGHT: first = n - 1;              step = -1;        stride = GRID_MAX; break;
+     case MOVE_UP:    first = 0;                  step = GRID_MAX;  stride = 1;        break;
+     default:         first = (n - 1) * GRID_MAX; step = -GRID_MAX; stride = 1;        break;
+     }
  
-     for (int r = 0; r < GRID_SIZE; r++) {
-         int tmp[GRID_SIZE] = {0};
-         int cnt = 0;
+     uint64_t line0 = (stride == 1) ? COL0_MASK : ROW0_MASK;
  
-         /* Compress non-zero tiles into tmp[] */
-         for (int c = 0; c < GRID_SIZE; c++) {
-             if (grid[r][c] != 0) {
-                 tmp[cnt++] = grid[r][c];
-             }
+     for (int i = 0; i < n; i++) {
+         /* nothing moves in an empty line */
+         if (!(occ & (line0 << (i * stride)))) {
+             continue;
          }
  
-         /* Merge adjacent equals */
-         for (int i = 0; i < cnt - 1; i++) {
-             if (tmp[i] && tmp[i] == tmp[i + 1]) {
-                 tmp[i] *= 2;
-                 tmp[i + 1] = 0;
-                 moved = true;
-             }
-         }
+         int base = first + i * stride;
+         int w = 0;     /* next write position along the line */
+         int last = 0;  /* value at w - 1 if it may still merge, else 0 */
  
-         /* Rebuild the row and detect any movement */
-         int final[GRID_SIZE] = {0};
-         int j = 0;
-         for (int i = 0; i < GRID_SIZE; i++) {
-             if (tmp[i] != 0) {
-                 final[j++] = tmp[i];
+         for (int k = 0; k < n; k++) {
+             int from = base + k * step;
+             int v = cell[from];
+             if (v == 0) {
+                 continue;
              }
-         }
-         for (int c = 0; c < GRID_SIZE; c++) {
-             if (grid[r][c] != final[c]) {
-                 moved = true;
-                 grid[r][c] = final[c];
+             if (v == last) {
+                 int to = base + (w - 1) * step;
+                 cell[to] = 2 * v;
+                 cell[from] = 0;
+                 occ &= ~(1ULL << from);
+                 gain += 2 * v;
+                 set_delta(d++, DELTA_MERGE, from, to, v);
+                 last = 0;
+             } else {
+                 if (k != w) {
+                     int to = base + w * step;
+                     cell[to] = v;
+                     cell[from] = 0;
+                     occ ^= (1ULL << from) | (1ULL << to);
+                     set_delta(d++, DELTA_SLIDE, from, to, v);
+                 }
+                 last = v;
+                 w++;
              }
          }
      }
  
-     return moved;
+     grid_occupied = occ;
+     game_score += gain;
+     last_deltas.count = (uint8_t)(d - last_deltas.d);
+     return last_deltas.count != 0;
  }
  
+ #define MOVE_KERNEL(n) \
+     static bool move_board_##n(enum move_dir dir) { return move_board(dir, n); }
+ 
+ MOVE_KERNEL(3)
+ MOVE_KERNEL(4)
+ MOVE_KERNEL(5)
+ MOVE_KERNEL(6)
+ MOVE_KERNEL(7)
+ MOVE_KERNEL(8)
+ 
+ BUILD_ASSERT(GRID_MIN == 3 && GRID_MAX == 8, "add a MOVE_KERNEL() per board size");
+ 
+ /* Move kernels indexed by grid_size - GRID_MIN */
+ static bool (*const move_kernels[])(enum move_dir) = {
+     move_board_3, move_board_4, move_board_5,
+     move_board_6, move_board_7, move_board_8,
+ };
+ static GAME_TLS bool (*move_kernel)(enum move_dir) = move_board_4;
+ 
  /**
-  * @brief Shift and merge all rows to the right.
-  *
-  * @return true if any tile moved or merged, false otherwise.
+  * @brief Select the board size used by the next init_game().
   */
- bool move_right(void)
+ bool set_grid_size(int n)
  {
-     /* Reverse each row, move left, reverse back */
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = 0; c < GRID_SIZE / 2; c++) {
-             int t = grid[r][c];
-             grid[r][c] = grid[r][GRID_SIZE - 1 - c];
-             grid[r][GRID_SIZE - 1 - c] = t;
-         }
+     if (n < GRID_MIN || n > GRID_MAX) {
+         return false;
      }
+     grid_size = n;
+     move_kernel = move_kernels[n - GRID_MIN];
+     board_mask = 0;
+     for (int r = 0; r < n; r++) {
+         board_mask |= ((1ULL << n) - 1) << (r * GRID_MAX);
+     }
+     return true;
+ }
  
-     bool moved = move_left();
+ /**
+  * @brief Shift and merge every line toward one edge.
+  */
+ bool move_tiles(enum move_dir dir)
+ {
+     return move_kernel(dir);
+ }
  
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = 0; c < GRID_SIZE / 2; c++) {
-             int t = grid[r][c];
-             grid[r][c] = grid[r][GRID_SIZE - 1 - c];
-             grid[r][GRID_SIZE - 1 - c] = t;
-         }
-     }
+ /**
+  * @brief Shift and merge all rows to the left.
+  *
+  * @return true if any tile moved or merged, false otherwise.
+  */
+ bool move_left(void)
+ {
+     return move_tiles(MOVE_LEFT);
+ }
  
-     return moved;
+ /**
+  * @brief Shift and merge all rows to the right.
+  *
+  * @return true if any tile moved or merged, false otherwise.
+  */
+ bool move_right(void)
+ {
+     return move_tiles(MOVE_RIGHT);
  }
  
  /**
@@ -161,26 +271,7 @@
   */
  bool move_up(void)
  {
-     /* Transpose, move left, transpose back */
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = r + 1; c < GRID_SIZE; c++) {
-             int t = grid[r][c];
-             grid[r][c] = grid[c][r];
-             grid[c][r] = t;
-         }
-     }
- 
-     bool moved = move_left();
- 
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = r + 1; c < GRID_SIZE; c++) {
-             int t = grid[r][c];
-             grid[r][c] = grid[c][r];
-             grid[c][r] = t;
-         }
-     }
- 
-     return moved;
+     return move_tiles(MOVE_UP);
  }
  
  /**
@@ -190,50 +281,31 @@
   */
  bool move_down(void)
  {
-     /* Transpose, move right, transpose back */
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = r + 1; c < GRID_SIZE; c++) {
-             int t = grid[r][c];
-             grid[r][c] = grid[c][r];
-             grid[c][r] = t;
-         }
-     }
- 
-     bool moved = move_right();
- 
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = r + 1; c < GRID_SIZE; c++) {
-             int t = grid[r][c];
-             grid[r][c] = grid[c][r];
-             grid[c][r] = t;
-         }
-     }
- 
-     return moved;
+     return move_tiles(MOVE_DOWN);
  }
  
  /**
   * @brief Check if any move is possible.
   *
-  * Scans for any empty cell or any pair of equal adjacent tiles.
+  * O(1) while the board has an empty cell; only a full board is scanned
+  * for equal neighbours.
   *
   * @return true if at least one move remains possible.
   */
  bool can_move(void)
  {
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = 0; c < GRID_SIZE; c++) {
-             if (grid[r][c] == 0) {
-                 return true;
-             }
-             if (c < GRID_SIZE - 1 && grid[r][c] == grid[r][c + 1]) {
+     if (grid_occupied != board_mask) {
+         return true;
+     }
+     for (int r = 0; r < grid_size; r++) {
+         for (int c = 0; c < grid_size; c++) {
+             if (c < grid_size - 1 && grid[r][c] == grid[r][c + 1]) {
                  return true;
              }
-             if (r < GRID_SIZE - 1 && grid[r][c] == grid[r + 1][c]) {
+             if (r < grid_size - 1 && grid[r][c] == grid[r + 1][c]) {
                  return true;
              }
          }
      }
      return false;
  }
- 
\ No newline at end of file
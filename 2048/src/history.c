@@ -0,0 +1,132 @@
+/* src/history.c
+ *
+ * Implements the undo / redo ring for the Zephyr‑2048 project:
+ * - history_reset(), history_push()
+ * - history_undo(), history_redo(), history_ram()
+ */
+
+ #include "config.h"
+ #include "history.h"
+ #include "game.h"
+ #include <stdint.h>
+ #include <string.h>
+
+ #if CONFIG_2048_UNDO_DEPTH > 0
+
+ /*
+  * Room for DEPTH undoable states of the largest board plus the current
+  * one. States are packed back to back with the stride of the board in
+  * play, so smaller boards keep more of them in the same bytes.
+  */
+ #define RING_BYTES ((CONFIG_2048_UNDO_DEPTH + 1) * HISTORY_ENTRY_SIZE(GRID_MAX))
+
+ static uint8_t ring[RING_BYTES];
+ /* Bytes per state and states that fit, set by history_reset() */
+ static uint16_t stride;
+ static uint16_t slots;
+ /* Slot of the oldest state, states kept, and position of the current one */
+ static uint16_t first;
+ static uint16_t count;
+ static uint16_t cur;
+
+ /* Pack grid[][] exponents LSB first, then game_score and game_rng_state */
+ static void encode(uint8_t *p)
+ {
+     uint32_t acc = 0;
+     int bits = 0;
+
+     for (int r = 0; r < grid_size; r++) {
+         for (int c = 0; c < grid_size; c++) {
+             uint32_t e = grid[r][c] ? (uint32_t)__builtin_ctz((unsigned int)grid[r][c]) : 0;
+             acc |= e << bits;
+             bits += 5;
+             while (bits >= 8) {
+                 *p++ = (uint8_t)acc;
+                 acc >>= 8;
+                 bits -= 8;
+             }
+         }
+     }
+     if (bits) {
+         *p++ = (uint8_t)acc;
+     }
+     memcpy(p, &game_score, sizeof(game_score));
+     memcpy(p + 4, &game_rng_state, sizeof(game_rng_state));
+ }
+
+ static void decode(const uint8_t *p)
+ {
+     uint32_t acc = 0;
+     int bits = 0;
+
+     for (int r = 0; r < grid_size; r++) {
+         for (int c = 0; c < grid_size; c++) {
+             if (bits < 5) {
+                 acc |= (uint32_t)*p++ << bits;
+                 bits += 8;
+             }
+             uint32_t e = acc & 0x1F;
+             acc >>= 5;
+             bits -= 5;
+             grid[r][c] = e ? 1 << e : 0;
+         }
+     }
+     memcpy(&game_score, p, sizeof(game_score));
+     memcpy(&game_rng_state, p + 4, sizeof(game_rng_state));
+     grid_changed();
+ }
+
+ static uint8_t *slot(int i)
+ {
+     return &ring[(first + i) % slots * stride];
+ }
+
+ void history_reset(void)
+ {
+     /* the board size may have changed since the last game */
+     stride = HISTORY_ENTRY_SIZE(grid_size);
+     slots = RING_BYTES / stride;
+     first = 0;
+     count = 1;
+     cur = 0;
+     encode(slot(0));
+ }
+
+ void history_push(void)
+ {
+     /* a new move replaces the redo states */
+     count = cur + 1;
+     if (count == slots) {
+         first = (first + 1) % slots;
+         count--;
+     }
+     cur = count;
+     count++;
+     encode(slot(cur));
+ }
+
+ bool history_undo(void)
+ {
+     if (cur == 0) {
+         return false;
+     }
+     decode(slot(--cur));
+     return true;
+ }
+
+ bool history_redo(void)
+ {
+     if (cur + 1 >= count) {
+         return false;
+     }
+     decode(slot(++cur));
+     return true;
+ }
+
+ size_t history_ram(void)
+ {
+     return sizeof(ring) + sizeof(stride) + sizeof(slots) + sizeof(first) + sizeof(count) +
+            sizeof(cur);
+ }
+
+ #endif /* CONFIG_2048_UNDO_DEPTH > 0 */
@@ -6,11 +6,47 @@
 
  #include "config.h"
  #include "input.h"
+ #include "move_queue.h"
+ #ifdef CONFIG_2048_PRECOMPUTE
+ #include "precompute.h"
+ #endif
+ #ifdef CONFIG_2048_SWIPE
+ #include "swipe.h"
+ #endif
  #include <lvgl.h>
+ #include <stdbool.h>
  #include <stdint.h>
+ #include <zephyr/kernel.h>
+ #include <zephyr/sys/printk.h>
+ #ifdef CONFIG_2048_INPUT_WAKEUP
+ #include <zephyr/input/input.h>
+ #include <zephyr/sys/atomic.h>
+ #endif
  
- /* direction_flag is defined in main.c */
- extern int8_t direction_flag;
+ #ifdef CONFIG_2048_AI
+ /* ai_request_flag is defined in main.c */
+ extern bool ai_request_flag;
+ #endif
+ 
+ /* Cycle count of the last touch-down: swipe latency is measured from it */
+ static uint32_t press_cyc;
+ 
+ /* Queue a move, unless the precomputed results show it changes nothing */
+ static void queue_move(int dir, uint32_t t_cyc)
+ {
+ #ifdef CONFIG_2048_PRECOMPUTE
+     /* the results describe the board on screen only while nothing is queued */
+     if (move_queue_empty() && !(precompute_valid_moves() & (1U << dir))) {
+         return;
+     }
+ #endif
+     move_queue_put_at(dir, t_cyc);
+ }
+ 
+ void press_event_cb(lv_event_t *e)
+ {
+     press_cyc = k_cycle_get_32();
+ }
  
  void gesture_event_cb(lv_event_t *e)
  {
@@ -19,14 +55,138 @@
      lv_dir_t dir = lv_indev_get_gesture_dir(indev);
  
      switch (dir) {
-     case LV_DIR_LEFT:   direction_flag = 1; break;
-     case LV_DIR_TOP:    direction_flag = 2; break;
-     case LV_DIR_RIGHT:  direction_flag = 3; break;
-     case LV_DIR_BOTTOM: direction_flag = 4; break;
+     case LV_DIR_LEFT:   queue_move(MOVE_LEFT, press_cyc);  break;
+     case LV_DIR_TOP:    queue_move(MOVE_UP, press_cyc);    break;
+     case LV_DIR_RIGHT:  queue_move(MOVE_RIGHT, press_cyc); break;
+     case LV_DIR_BOTTOM: queue_move(MOVE_DOWN, press_cyc);  break;
      default: break;
      }
  }
  
+ #ifdef CONFIG_2048_SWIPE
+ 
+ static struct swipe swipe = {
+     .p = {
+         .commit_px      = CONFIG_2048_SWIPE_COMMIT_PX,
+         .min_px         = CONFIG_2048_SWIPE_MIN_PX,
+         .min_speed      = CONFIG_2048_SWIPE_MIN_SPEED,
+         .axis_ratio_pct = CONFIG_2048_SWIPE_AXIS_RATIO,
+     },
+ };
+ 
+ void swipe_event_cb(lv_event_t *e)
+ {
+     enum swipe_phase phase;
+     lv_point_t p;
+ 
+     switch (lv_event_get_code(e)) {
+     case LV_EVENT_PRESSED:
+         press_cyc = k_cycle_get_32();
+         phase = SWIPE_DOWN;
+         break;
+     case LV_EVENT_PRESSING:
+         phase = SWIPE_MOVE;
+         break;
+     case LV_EVENT_RELEASED:
+     case LV_EVENT_PRESS_LOST:
+         phase = SWIPE_UP;
+         break;
+     default:
+         return;
+     }
+ 
+     lv_indev_get_point(lv_indev_get_act(), &p);
+     uint32_t t_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+ #ifdef CONFIG_2048_SWIPE_TRACE
+     /* one line per sample, the input format of tools/swipe_replay.c */
+     printk("swipe: %c %u %d %d\n", "DMU"[phase], t_us, (int)p.x, (int)p.y);
+ #endif
+ 
+     enum move_dir dir = swipe_feed(&swipe, phase, p.x, p.y, t_us);
+     if (dir != MOVE_NONE) {
+         queue_move(dir, press_cyc);
+     }
+ }
+ 
+ #endif /* CONFIG_2048_SWIPE */
+ 
+ #ifdef CONFIG_2048_INPUT_WAKEUP
+ 
+ /* Set by the input thread when LVGL has unread touch data */
+ static atomic_t input_pending;
+ 
+ /*
+  * Runs for every input event, after LVGL's own lvgl_*_process_event
+  * callbacks (input callbacks are sorted by name), so the touch sample is
+  * already in LVGL's queue when main() wakes up and reads it.
+  */
+ static void wakeup_on_input(struct input_event *evt, void *user_data)
+ {
+     if (evt->sync) {
+         atomic_set(&input_pending, 1);
+         move_queue_wake();
+     }
+ }
+ INPUT_CALLBACK_DEFINE(NULL, wakeup_on_input, NULL);
+ 
+ void input_poll(void)
+ {
+     if (!atomic_cas(&input_pending, 1, 0)) {
+         return;
+     }
+     /* read now instead of at the next indev timer tick */
+     for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+         lv_indev_read(indev);
+     }
+ }
+ 
+ #endif /* CONFIG_2048_INPUT_WAKEUP */
+ 
+ #ifdef CONFIG_2048_AI
+ 
+ void long_press_event_cb(lv_event_t *e)
+ {
+     ai_request_flag = true;
+     move_queue_wake();
+ }
+ 
+ #endif /* CONFIG_2048_AI */
+ 
+ #if CONFIG_2048_UNDO_DEPTH > 0
+ 
+ /* Undo / redo button event: queue the command behind pending moves */
+ static void history_btn_event_cb(lv_event_t *e)
+ {
+     move_queue_put((int)(intptr_t)lv_event_get_user_data(e));
+ }
+ 
+ /* Create the undo (top-left) and redo (top-right) corner buttons */
+ void create_history_buttons(lv_obj_t *parent)
+ {
+     static const struct {
+         lv_align_t align;
+         const char *text;
+         int cmd;
+     } btns[] = {
+         { LV_ALIGN_TOP_LEFT,  LV_SYMBOL_LEFT " Undo",  CMD_UNDO },
+         { LV_ALIGN_TOP_RIGHT, "Redo " LV_SYMBOL_RIGHT, CMD_REDO },
+     };
+ 
+     for (int i = 0; i < 2; i++) {
+         lv_obj_t *btn = lv_btn_create(parent);
+         lv_obj_align(btn, btns[i].align, 0, 0);
+         lv_obj_set_style_bg_color(btn, lv_color_hex(0x8F7A66), 0);
+         lv_obj_set_style_bg_opa(btn, LV_OPA_70, 0);
+         lv_obj_set_style_pad_all(btn, 4, 0);
+         lv_obj_add_event_cb(btn, history_btn_event_cb, LV_EVENT_CLICKED,
+                             (void *)(intptr_t)btns[i].cmd);
+         lv_obj_t *label = lv_label_create(btn);
+         lv_label_set_text(label, btns[i].text);
+     }
+ }
+ 
+ #endif /* CONFIG_2048_UNDO_DEPTH > 0 */
+ 
  #ifdef CONFIG_2048_USE_BUTTONS_TO_MOVE
  
  /* LVGL animation callback to scale button */
@@ -49,12 +209,12 @@
      lv_anim_start(&a);
  }
  
- /* Direction button event: animate and set flag */
+ /* Direction button event: animate and queue the move */
  static void btn_event_cb(lv_event_t *e)
  {
      lv_obj_t *btn = lv_event_get_target(e);
      animate_button(btn);
-     direction_flag = (int)(intptr_t)lv_event_get_user_data(e);
+     queue_move((int)(intptr_t)lv_event_get_user_data(e), k_cycle_get_32());
  }
  
  /* Create transparent edge buttons for tap-based movement */
@@ -14,6 +14,23 @@
  #include "game.h"
  #include "ui.h"
  #include "input.h"
+ #include "move_queue.h"
+ #ifdef CONFIG_2048_ANIM
+ #include "anim.h"
+ #endif
+ #ifdef CONFIG_2048_AI
+ #include "ai.h"
+ #include "bitboard.h"
+ #endif
+ #ifdef CONFIG_2048_BENCH
+ #include "bench.h"
+ #endif
+ #if CONFIG_2048_UNDO_DEPTH > 0
+ #include "history.h"
+ #endif
+ #ifdef CONFIG_2048_PRECOMPUTE
+ #include "precompute.h"
+ #endif
  
  #include <zephyr/device.h>
  #include <zephyr/devicetree.h>
@@ -22,8 +39,149 @@
  #include <lvgl.h>
  #include <stdbool.h>
  
- /* Shared move flag, set by gesture_event_cb() or create_buttons() callbacks */
- int8_t direction_flag = 0;
+ /* Longest sleep between two LVGL runs when no timer is due sooner */
+ #define IDLE_WAIT_MS 100
+
+ /* Board size picked in the size menu, 0 while none is pending */
+ int size_request = 0;
+
+ #ifdef CONFIG_2048_AI
+ /* Set by long_press_event_cb() */
+ bool ai_request_flag = false;
+ 
+ /* Search the current grid and log how much search the budget bought */
+ static enum move_dir ai_pick_move(void)
+ {
+     struct ai_stats st;
+
+     /* the bitboard search only knows 4×4 */
+     if (grid_size != 4) {
+         return MOVE_NONE;
+     }
+
+     enum move_dir dir = ai_best_move(bb_from_grid(grid),
+                                      CONFIG_2048_AI_TIME_BUDGET_MS, &st);
+     uint32_t knps = st.elapsed_us ? (uint32_t)((uint64_t)st.nodes * 1000U / st.elapsed_us) : 0;
+ 
+     printk("ai: dir %d depth %u nodes %u in %u us (%u knodes/s)\n",
+            dir, st.depth, st.nodes, st.elapsed_us, knps);
+     return dir;
+ }
+ #endif
+ 
+ #ifdef CONFIG_2048_INPUT_STATS
+ /* Queue-to-grid latency of the moves since the last report */
+ static uint32_t lat_min = UINT32_MAX, lat_max, lat_sum, lat_n;
+ 
+ static void record_latency(uint32_t t_cyc)
+ {
+     uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - t_cyc);
+ 
+     lat_min = MIN(lat_min, us);
+     lat_max = MAX(lat_max, us);
+     lat_sum += us;
+     if (++lat_n == CONFIG_2048_INPUT_STATS_INTERVAL) {
+         printk("input: %u moves, latency min %u avg %u max %u us, %u dropped\n",
+                lat_n, lat_min, lat_sum / lat_n, lat_max, move_queue_dropped());
+         lat_min = UINT32_MAX;
+         lat_max = lat_sum = lat_n = 0;
+     }
+ }
+ #endif
+ 
+ /* Replace the board and menu with a new n×n game */
+ static void start_game(lv_obj_t *scr, int n)
+ {
+ #ifdef CONFIG_2048_ANIM
+     anim_cancel();
+ #endif
+     destroy_size_menu();
+     destroy_board();
+     set_grid_size(n);
+     create_board(scr);
+ #ifdef CONFIG_2048_ANIM
+     anim_init();
+ #endif
+     init_game();
+ #ifdef CONFIG_2048_PRECOMPUTE
+     precompute_invalidate();
+ #endif
+ #if CONFIG_2048_UNDO_DEPTH > 0
+     history_reset();
+ #endif
+     update_ui();
+ #ifdef CONFIG_2048_ANIM
+     anim_play(&last_deltas);
+ #endif
+ }
+ 
+ #if CONFIG_2048_UNDO_DEPTH > 0
+ /* Step through the history; repaints only the cells that differ */
+ static void apply_history_cmd(uint8_t cmd)
+ {
+     bool ok = (cmd == CMD_UNDO) ? history_undo() : history_redo();
+ 
+     if (ok) {
+ #ifdef CONFIG_2048_PRECOMPUTE
+         precompute_invalidate();
+ #endif
+         /* undoing the last move of a lost game resumes it */
+         destroy_size_menu();
+ #ifdef CONFIG_2048_AI
+         show_hint(MOVE_NONE);
+ #endif
+         update_ui();
+     }
+ }
+ #endif
+ 
+ /*
+  * Move and spawn; report the cells to repaint and whether the game is
+  * over. Returns false if the move changes nothing.
+  */
+ static bool play_move(enum move_dir dir, uint64_t *changed, bool *over)
+ {
+ #ifdef CONFIG_2048_PRECOMPUTE
+     /* normally done already, while the loop waited for this move */
+     precompute_run();
+     return precompute_commit(dir, changed, over);
+ #else
+     if (!move_tiles(dir)) {
+         return false;
+     }
+     spawn_tile();
+     *changed = UINT64_MAX;
+     *over = !can_move();
+     return true;
+ #endif
+ }
+ 
+ /* Apply one queued move, spawn and redraw */
+ static void apply_move(lv_obj_t *scr, const struct move_cmd *cmd)
+ {
+     uint64_t changed;
+     bool over;
+ 
+     if (!play_move((enum move_dir)cmd->dir, &changed, &over)) {
+         return;
+     }
+ #ifdef CONFIG_2048_AI
+     show_hint(MOVE_NONE);
+ #endif
+ #if CONFIG_2048_UNDO_DEPTH > 0
+     history_push();
+ #endif
+     update_cells(changed);
+ #ifdef CONFIG_2048_ANIM
+     anim_play(&last_deltas);
+ #endif
+ #ifdef CONFIG_2048_INPUT_STATS
+     record_latency(cmd->t_cyc);
+ #endif
+     if (over) {
+         create_size_menu(scr, "Game Over");
+     }
+ }
  
  int main(void)
  {
@@ -38,39 +196,85 @@
  
      /* Build the UI */
      lv_obj_t *scr = lv_scr_act();
-     create_board(scr);
  #ifdef CONFIG_2048_USE_BUTTONS_TO_MOVE
      create_buttons(scr);
  #endif
+ #if CONFIG_2048_UNDO_DEPTH > 0
+     create_history_buttons(scr);
+     printk("undo: depth %d, %u bytes of RAM\n",
+            CONFIG_2048_UNDO_DEPTH, (unsigned int)history_ram());
+ #endif
+ #ifdef CONFIG_2048_SWIPE
+     lv_obj_add_event_cb(scr, swipe_event_cb, LV_EVENT_ALL, NULL);
+ #else
+     lv_obj_add_event_cb(scr, press_event_cb, LV_EVENT_PRESSED, NULL);
      lv_obj_add_event_cb(scr, gesture_event_cb, LV_EVENT_GESTURE, NULL);
+ #endif
+ #ifdef CONFIG_2048_AI
+     lv_obj_add_event_cb(scr, long_press_event_cb, LV_EVENT_LONG_PRESSED, NULL);
+     ai_init();
+     bool autoplay = false;
+ #endif
  
-     /* Initialize game logic and first draw */
-     init_game();
-     update_ui();
+     /* Let the player pick a board size; the game starts from the loop */
+ #ifdef CONFIG_2048_BENCH
+     bench_run();
+ #endif
+     create_size_menu(scr, "2048");
  
      /* Main loop */
      while (1) {
-         if (direction_flag) {
-             bool moved = false;
-             switch (direction_flag) {
-             case 1: moved = move_left();  break;
-             case 2: moved = move_up();    break;
-             case 3: moved = move_right(); break;
-             case 4: moved = move_down();  break;
-             }
-             if (moved) {
-                 spawn_tile();
-                 update_ui();
-                 if (!can_move()) {
-                     lv_obj_t *msg = lv_label_create(scr);
-                     lv_label_set_text(msg, "Game Over");
-                     lv_obj_center(msg);
-                 }
+         if (size_request) {
+             start_game(scr, size_request);
+             size_request = 0;
+         }
+ #ifdef CONFIG_2048_AI
+         if (ai_request_flag) {
+             ai_request_flag = false;
+ #ifdef CONFIG_2048_AI_MODE_AUTOPLAY
+             autoplay = !autoplay;
+ #else
+             show_hint(ai_pick_move());
+ #endif
+         }
+         /* One search per loop pass, bounded by the time budget */
+         if (autoplay && move_queue_empty()) {
+             enum move_dir dir = ai_pick_move();
+             autoplay = (dir != MOVE_NONE) && move_queue_put(dir);
+         }
+ #endif
+         /* One move per pass, so every queued swipe gets drawn */
+         struct move_cmd cmd;
+         if (move_queue_get(&cmd)) {
+ #ifdef CONFIG_2048_ANIM
+             /* finish the previous move's animation instantly */
+             anim_cancel();
+ #endif
+             switch (cmd.dir) {
+ #if CONFIG_2048_UNDO_DEPTH > 0
+             case CMD_UNDO:
+             case CMD_REDO:
+                 apply_history_cmd(cmd.dir);
+                 break;
+ #endif
+             default:
+                 apply_move(scr, &cmd);
+                 break;
              }
-             direction_flag = 0;
          }
-         lv_timer_handler();
-         k_sleep(K_MSEC(50));
+ 
+         /* Sleep until LVGL's next timer is due or a move / touch arrives */
+         uint32_t next_ms = lv_timer_handler();
+ #ifdef CONFIG_2048_PRECOMPUTE
+         /* the frame is out: prepare the next move before sleeping */
+         if (move_queue_empty()) {
+             precompute_run();
+         }
+ #endif
+         move_queue_wait(K_MSEC(MIN(next_ms, IDLE_WAIT_MS)));
+ #ifdef CONFIG_2048_INPUT_WAKEUP
+         input_poll();
+ #endif
      }
  
      return 0;
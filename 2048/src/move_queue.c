@@ -0,0 +1,85 @@
+/* src/move_queue.c
+ *
+ * Implements the move command ring for the Zephyr‑2048 project:
+ * - move_queue_put(), move_queue_put_at(), move_queue_get(), move_queue_empty()
+ * - move_queue_wake(), move_queue_wait(), move_queue_dropped()
+ */
+
+ #include "config.h"
+ #include "move_queue.h"
+ #include <zephyr/kernel.h>
+ #include <zephyr/sys/atomic.h>
+
+ #define QUEUE_LEN CONFIG_2048_MOVE_QUEUE_LEN
+ BUILD_ASSERT((QUEUE_LEN & (QUEUE_LEN - 1)) == 0, "2048_MOVE_QUEUE_LEN must be a power of two");
+
+ static struct move_cmd ring[QUEUE_LEN];
+ /*
+  * Free-running indices: head is written only by the producer, tail only
+  * by the consumer. head - tail is the fill level, even across wraparound.
+  */
+ static atomic_t head;
+ static atomic_t tail;
+ static atomic_t dropped;
+
+ /* Counts at most one pending wakeup */
+ static K_SEM_DEFINE(wake_sem, 0, 1);
+
+ bool move_queue_put(int dir)
+ {
+     return move_queue_put_at(dir, k_cycle_get_32());
+ }
+ 
+ bool move_queue_put_at(int dir, uint32_t t_cyc)
+ {
+     atomic_val_t h = atomic_get(&head);
+
+     if ((atomic_val_t)(h - atomic_get(&tail)) >= QUEUE_LEN) {
+         atomic_inc(&dropped);
+         return false;
+     }
+
+     ring[h & (QUEUE_LEN - 1)] = (struct move_cmd){
+         .dir = (uint8_t)dir,
+         .t_cyc = t_cyc,
+     };
+     /* publish the entry before the index (atomic_set is a full barrier) */
+     atomic_set(&head, h + 1);
+     k_sem_give(&wake_sem);
+     return true;
+ }
+
+ bool move_queue_get(struct move_cmd *cmd)
+ {
+     atomic_val_t t = atomic_get(&tail);
+
+     if (t == atomic_get(&head)) {
+         return false;
+     }
+     *cmd = ring[t & (QUEUE_LEN - 1)];
+     atomic_set(&tail, t + 1);
+     return true;
+ }
+
+ bool move_queue_empty(void)
+ {
+     return atomic_get(&tail) == atomic_get(&head);
+ }
+
+ void move_queue_wake(void)
+ {
+     k_sem_give(&wake_sem);
+ }
+
+ void move_queue_wait(k_timeout_t timeout)
+ {
+     /* a put between the check and the take leaves the semaphore given */
+     if (move_queue_empty()) {
+         (void)k_sem_take(&wake_sem, timeout);
+     }
+ }
+
+ uint32_t move_queue_dropped(void)
+ {
+     return (uint32_t)atomic_get(&dropped);
+ }
@@ -0,0 +1,111 @@
+/* src/ntuple.c
+ *
+ * Implements the learned N-tuple evaluator:
+ * blob validation, symmetric tuple lookup, and the 1-ply greedy player.
+ * Free of Zephyr dependencies so the host trainer links the same code.
+ */
+
+ #include "config.h"
+ #include "ntuple.h"
+ #include "bitboard.h"
+ #include <stddef.h>
+ #include <stdint.h>
+
+ /* Map cell (r, c) through one of the eight board symmetries */
+ static int sym_cell(int cell, int s)
+ {
+     int r = cell / 4, c = cell % 4, t;
+
+     if (s & 4) {
+         t = r; r = c; c = t;
+     }
+     if (s & 1) {
+         c = 3 - c;
+     }
+     if (s & 2) {
+         r = 3 - r;
+     }
+     return r * 4 + c;
+ }
+
+ /**
+  * @brief Validate a weight blob and prepare a network that reads it in place.
+  */
+ int ntuple_load(const void *blob, size_t size, struct ntuple_net *net)
+ {
+     const struct ntuple_header *hdr = blob;
+
+     if (size < sizeof(*hdr) || hdr->magic != NTUPLE_MAGIC ||
+         hdr->version != NTUPLE_VERSION ||
+         hdr->n_tuples == 0 || hdr->n_tuples > NTUPLE_MAX_TUPLES ||
+         hdr->tuple_len == 0 || hdr->tuple_len > NTUPLE_MAX_LEN ||
+         hdr->alphabet < 2 || hdr->alphabet > 16) {
+         return -1;
+     }
+
+     uint32_t table_size = 1;
+     for (int i = 0; i < hdr->tuple_len; i++) {
+         table_size *= hdr->alphabet;
+     }
+     if (size < sizeof(*hdr) +
+                (size_t)hdr->n_tuples * table_size * sizeof(int16_t)) {
+         return -1;
+     }
+
+     for (int t = 0; t < hdr->n_tuples; t++) {
+         for (int i = 0; i < hdr->tuple_len; i++) {
+             if (hdr->cells[t][i] >= 16) {
+                 return -1;
+             }
+             for (int s = 0; s < 8; s++) {
+                 net->shifts[t][s][i] = (uint8_t)(4 * sym_cell(hdr->cells[t][i], s));
+             }
+         }
+     }
+
+     net->hdr = hdr;
+     net->weights = (const int16_t *)(hdr + 1);
+     net->table_size = table_size;
+     return 0;
+ }
+
+ /**
+  * @brief Compute the position value of an afterstate.
+  */
+ int32_t ntuple_eval(const struct ntuple_net *net, bb_board_t b)
+ {
+     int32_t sum = 0;
+
+     for (int t = 0; t < net->hdr->n_tuples; t++) {
+         const int16_t *w = net->weights + (size_t)t * net->table_size;
+         for (int s = 0; s < 8; s++) {
+             sum += w[ntuple_index(net, t, s, b)];
+         }
+     }
+
+     return net->hdr->shift >= 0 ? sum * (1 << net->hdr->shift)
+                                 : sum >> -net->hdr->shift;
+ }
+
+ /**
+  * @brief Pick the move with the best reward plus afterstate value (1-ply greedy).
+  */
+ enum move_dir ntuple_best_move(const struct ntuple_net *net, bb_board_t b)
+ {
+     enum move_dir best_dir = MOVE_NONE;
+     int32_t best = INT32_MIN;
+     uint32_t base = bb_score(b);
+
+     for (int d = MOVE_LEFT; d <= MOVE_DOWN; d++) {
+         bb_board_t nb = bb_move(b, (enum move_dir)d);
+         if (nb == b) {
+             continue;
+         }
+         int32_t v = (int32_t)(bb_score(nb) - base) + ntuple_eval(net, nb);
+         if (v > best) {
+             best = v;
+             best_dir = (enum move_dir)d;
+         }
+     }
+     return best_dir;
+ }
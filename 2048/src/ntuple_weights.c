@@ -0,0 +1,20 @@
+/* src/ntuple_weights.c
+ *
+ * Flash-resident N-tuple weight blob, generated at build time from
+ * data/ntuple_weights.bin (see tools/ntuple_train.c).
+ */
+
+ #include "ntuple.h"
+ #include <stddef.h>
+ #include <stdint.h>
+ #include <zephyr/toolchain.h>
+
+ #ifdef CONFIG_2048_AI_NTUPLE
+
+ const uint8_t ntuple_weights[] __aligned(4) = {
+ #include "ntuple_weights.bin.inc"
+ };
+
+ const size_t ntuple_weights_size = sizeof(ntuple_weights);
+
+ #endif /* CONFIG_2048_AI_NTUPLE */
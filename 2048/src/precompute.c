@@ -0,0 +1,114 @@
+/* src/precompute.c
+ *
+ * Implements speculative move results for the Zephyr‑2048 project:
+ * - precompute_invalidate(), precompute_run()
+ * - precompute_valid_moves(), precompute_commit()
+ */
+
+ #include "config.h"
+ #include "precompute.h"
+ #include "game.h"
+ #include <string.h>
+
+ #ifdef CONFIG_2048_PRECOMPUTE
+
+ /* Game state written by a move plus its spawn */
+ struct state {
+     int grid[GRID_MAX][GRID_MAX];
+     uint64_t occupied;
+     uint32_t score;
+     uint32_t rng;
+     struct move_deltas deltas;
+ };
+
+ struct result {
+     struct state s;
+     uint64_t changed;  /* cells whose value differs from the current game */
+     bool over;         /* no move possible afterwards */
+ };
+
+ /* Indexed by dir - MOVE_LEFT; only valid moves are filled in */
+ static struct result results[4];
+ static uint8_t valid;
+ static bool ready;
+
+ static void save(struct state *s)
+ {
+     memcpy(s->grid, grid, sizeof(grid));
+     s->occupied = grid_occupied;
+     s->score = game_score;
+     s->rng = game_rng_state;
+     s->deltas = last_deltas;
+ }
+
+ static void restore(const struct state *s)
+ {
+     memcpy(grid, s->grid, sizeof(grid));
+     grid_occupied = s->occupied;
+     game_score = s->score;
+     game_rng_state = s->rng;
+     last_deltas = s->deltas;
+ }
+
+ void precompute_invalidate(void)
+ {
+     ready = false;
+ }
+
+ void precompute_run(void)
+ {
+     static struct state cur;
+
+     if (ready) {
+         return;
+     }
+     save(&cur);
+     valid = 0;
+     for (int dir = MOVE_LEFT; dir <= MOVE_DOWN; dir++) {
+         struct result *res = &results[dir - MOVE_LEFT];
+
+         if (!move_tiles((enum move_dir)dir)) {
+             /* a refused move still cleared last_deltas */
+             restore(&cur);
+             continue;
+         }
+         spawn_tile();
+         save(&res->s);
+         res->over = !can_move();
+         res->changed = 0;
+         for (int r = 0; r < grid_size; r++) {
+             for (int c = 0; c < grid_size; c++) {
+                 if (grid[r][c] != cur.grid[r][c]) {
+                     res->changed |= CELL_BIT(r, c);
+                 }
+             }
+         }
+         valid |= 1U << dir;
+         restore(&cur);
+     }
+     ready = true;
+ }
+
+ uint8_t precompute_valid_moves(void)
+ {
+     if (!ready) {
+         return (1U << MOVE_LEFT) | (1U << MOVE_UP) | (1U << MOVE_RIGHT) | (1U << MOVE_DOWN);
+     }
+     return valid;
+ }
+
+ bool precompute_commit(enum move_dir dir, uint64_t *changed, bool *over)
+ {
+     if (!ready || !(valid & (1U << dir))) {
+         return false;
+     }
+     const struct result *res = &results[dir - MOVE_LEFT];
+
+     restore(&res->s);
+     *changed = res->changed;
+     *over = res->over;
+     ready = false;
+     return true;
+ }
+
+ #endif /* CONFIG_2048_PRECOMPUTE */
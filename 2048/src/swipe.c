@@ -0,0 +1,66 @@
+/* src/swipe.c
+ *
+ * Implements the touch-sample swipe recognizer:
+ * - swipe_init(), swipe_feed()
+ */
+
+ #include "config.h"
+ #include "swipe.h"
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include <stdlib.h>
+
+ void swipe_init(struct swipe *s, const struct swipe_params *p)
+ {
+     s->p = *p;
+     s->active = false;
+ }
+
+ /* Direction of displacement (dx, dy) if one axis dominates enough */
+ static enum move_dir classify(const struct swipe *s, int32_t dx, int32_t dy, int32_t *len)
+ {
+     int32_t ax = abs(dx), ay = abs(dy);
+     int32_t major = ax > ay ? ax : ay;
+     int32_t minor = ax > ay ? ay : ax;
+
+     *len = major;
+     if (major * 100 < (int32_t)s->p.axis_ratio_pct * minor) {
+         return MOVE_NONE;
+     }
+     if (ax > ay) {
+         return dx > 0 ? MOVE_RIGHT : MOVE_LEFT;
+     }
+     return dy > 0 ? MOVE_DOWN : MOVE_UP;
+ }
+
+ enum move_dir swipe_feed(struct swipe *s, enum swipe_phase phase,
+                          int32_t x, int32_t y, uint32_t t_us)
+ {
+     if (phase == SWIPE_DOWN) {
+         s->active = true;
+         s->x0 = x;
+         s->y0 = y;
+         s->t0_us = t_us;
+         return MOVE_NONE;
+     }
+     if (!s->active) {
+         return MOVE_NONE;
+     }
+
+     int32_t len;
+     enum move_dir dir = classify(s, x - s->x0, y - s->y0, &len);
+     bool commit = false;
+
+     if (dir != MOVE_NONE && len >= s->p.min_px) {
+         uint32_t dt_us = t_us - s->t0_us;
+
+         commit = len >= s->p.commit_px
+               || phase == SWIPE_UP
+               /* len / dt >= min_speed, in px/s */
+               || (uint64_t)len * 1000000U >= (uint64_t)s->p.min_speed * dt_us;
+     }
+     if (phase == SWIPE_UP || commit) {
+         s->active = false;
+     }
+     return commit ? dir : MOVE_NONE;
+ }
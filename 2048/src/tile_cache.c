@@ -0,0 +1,127 @@
+/* src/tile_cache.c
+ *
+ * Implements the pre-rendered tile bitmap cache for the Zephyr‑2048 project:
+ * - tile_cache_init(), tile_cache_acquire(), tile_cache_release()
+ * - tile_cache_get_stats()
+ */
+
+ #include "config.h"
+ #include "tile_cache.h"
+ #include "ui.h"
+ #include <lvgl.h>
+ #include <zephyr/sys/printk.h>
+ #include <zephyr/sys/util.h>
+
+ #ifdef CONFIG_2048_TILE_CACHE
+
+ /* More slots than distinct tile values are never useful */
+ #define MAX_SLOTS  18
+ #define POOL_BYTES (CONFIG_2048_TILE_CACHE_KB * 1024)
+
+ struct slot {
+     lv_draw_buf_t buf;
+     int      value;  /* tile value rendered here, -1 = none */
+     uint16_t pins;   /* cells showing this slot */
+     uint32_t used;   /* tick of the last acquire, for LRU */
+ };
+
+ static uint8_t pool[POOL_BYTES] __aligned(LV_DRAW_BUF_ALIGN);
+ static struct slot slots[MAX_SLOTS];
+ static int n_slots;
+ static uint32_t tick;
+ static struct tile_cache_stats stats;
+
+ /*
+  * Rendering template: a tile on a board-colored screen of its own, so the
+  * rounded corners come out in the board color in an opaque bitmap. The
+  * screen is never loaded, so rendering into it invalidates nothing.
+  */
+ static lv_obj_t *tmpl;
+
+ void tile_cache_init(lv_obj_t *board, int w, int h)
+ {
+     lv_color_format_t cf = lv_display_get_color_format(lv_display_get_default());
+     uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+     uint32_t size = LV_ROUND_UP(stride * h, LV_DRAW_BUF_ALIGN);
+
+     n_slots = MIN(MAX_SLOTS, POOL_BYTES / size);
+     for (int i = 0; i < n_slots; i++) {
+         struct slot *s = &slots[i];
+         lv_draw_buf_init(&s->buf, w, h, cf, stride, pool + i * size, size);
+         s->value = -1;
+         s->pins = 0;
+         s->used = 0;
+     }
+     stats = (struct tile_cache_stats){ .slots = (uint16_t)n_slots };
+
+     if (tmpl) {
+         lv_obj_delete(tmpl);
+     }
+     tmpl = lv_obj_create(NULL);
+     lv_obj_remove_style_all(tmpl);
+     lv_obj_set_size(tmpl, w, h);
+     lv_obj_set_style_bg_color(tmpl, lv_obj_get_style_bg_color(board, 0), 0);
+     lv_obj_set_style_bg_opa(tmpl, LV_OPA_COVER, 0);
+     create_tile(tmpl, w, h);
+
+ #ifdef CONFIG_2048_UI_STATS
+     printk("tiles: %d cached bitmaps of %dx%d (%u bytes each)\n", n_slots, w, h, size);
+ #endif
+ }
+
+ /* Render value v into slot s */
+ static void render(struct slot *s, int v)
+ {
+     set_tile_value(lv_obj_get_child(tmpl, 0), v);
+     lv_obj_update_layout(tmpl);
+     lv_snapshot_take_to_draw_buf(tmpl, s->buf.header.cf, &s->buf);
+     /* the slot pointer is reused as an image source for another value */
+     lv_image_cache_drop(&s->buf);
+     s->value = v;
+ }
+
+ const lv_draw_buf_t *tile_cache_acquire(int v)
+ {
+     struct slot *victim = NULL;
+
+     tick++;
+     for (int i = 0; i < n_slots; i++) {
+         struct slot *s = &slots[i];
+         if (s->value == v) {
+             s->pins++;
+             s->used = tick;
+             stats.hits++;
+             return &s->buf;
+         }
+         if (s->pins == 0 && (!victim || s->used < victim->used)) {
+             victim = s;
+         }
+     }
+
+     if (!victim) {
+         stats.fallbacks++;
+         return NULL;
+     }
+     render(victim, v);
+     victim->pins = 1;
+     victim->used = tick;
+     stats.renders++;
+     return &victim->buf;
+ }
+
+ void tile_cache_release(int v)
+ {
+     for (int i = 0; i < n_slots; i++) {
+         if (slots[i].value == v && slots[i].pins) {
+             slots[i].pins--;
+             return;
+         }
+     }
+ }
+
+ void tile_cache_get_stats(struct tile_cache_stats *st)
+ {
+     *st = stats;
+ }
+
+ #endif /* CONFIG_2048_TILE_CACHE */
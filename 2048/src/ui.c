@@ -2,16 +2,108 @@
  *
  * Implements UI API for the Zephyr‑2048 project:
  * - get_bg_color(), get_text_color()
- * - create_board(), update_ui()
+ * - create_board(), destroy_board(), update_ui(), update_cells()
+ * - create_size_menu(), destroy_size_menu()
+ * - create_tile(), set_tile_value(), get_cell(), paint_cell()
  */
 
  #include "config.h"
  #include "ui.h"
  #include "game.h"
+ #include "move_queue.h"
+ #include "tile_cache.h"
  #include <lvgl.h>
  #include <stdio.h>
+ #include <zephyr/sys/printk.h>
+ #ifdef CONFIG_2048_UI_STATS
+ #include <lvgl_mem.h>
+ #include <zephyr/kernel.h>
+ #endif
  
- static lv_obj_t *cells[GRID_SIZE][GRID_SIZE];
+ /* size_request is defined in main.c */
+ extern int size_request;
+ 
+ /* Cells shorter than this (px) use the small label font */
+ #define SMALL_FONT_CELL_H 40
+ 
+ /* Tile styles by exponent: 0 = empty, 1..11 = 2..2048, 12 = anything larger */
+ #define TILE_STYLE_COUNT 13
+ 
+ static lv_obj_t *board;
+ static lv_obj_t *cells[GRID_MAX][GRID_MAX];
+ static lv_obj_t *size_menu;
+ 
+ /*
+  * Built once by create_board() and shared by every tile / label.
+  * Each tile's user data holds the tile_styles[] index attached to it.
+  */
+ static lv_style_t tile_styles[TILE_STYLE_COUNT];
+ static lv_style_t cell_style;
+ static lv_style_t label_style;
+ 
+ /* Value each cell showed after the last update_ui(); -1 forces a repaint */
+ static int shown[GRID_MAX][GRID_MAX];
+ #ifdef CONFIG_2048_TILE_CACHE
+ /* Cell shows a cached bitmap of shown[][] (and holds a pin on it) */
+ static bool cached[GRID_MAX][GRID_MAX];
+ #endif
+ #ifdef CONFIG_2048_AI
+ static lv_obj_t *hint_label;
+ #endif
+ 
+ #ifdef CONFIG_2048_UI_STATS
+ /* Cells restyled and area invalidated since the last update_ui() */
+ static uint32_t stat_cells;
+ static uint32_t stat_px;
+ static bool stat_pending;
+ static uint32_t stat_refr_start;
+ 
+ /* Sum every invalidated area (before LVGL joins overlapping ones) */
+ static void invalidate_area_cb(lv_event_t *e)
+ {
+     const lv_area_t *area = lv_event_get_param(e);
+     stat_px += lv_area_get_size(area);
+ }
+ 
+ /* Time every refresh from its start */
+ static void refr_start_cb(lv_event_t *e)
+ {
+     stat_refr_start = k_cycle_get_32();
+ }
+ 
+ /* Report once the refresh that follows a move has finished */
+ static void refr_ready_cb(lv_event_t *e)
+ {
+     if (stat_pending) {
+         uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - stat_refr_start);
+         struct sys_memory_stats heap;
+ 
+         lvgl_heap_stats(&heap);
+         printk("ui: %u cells repainted, %u px invalidated in %u us, LVGL heap %u used (max %u)\n",
+                stat_cells, stat_px, us, (unsigned int)heap.allocated_bytes,
+                (unsigned int)heap.max_allocated_bytes);
+ #ifdef CONFIG_2048_TILE_CACHE
+         struct tile_cache_stats tc;
+ 
+         tile_cache_get_stats(&tc);
+         printk("ui: tile cache %u slots, %u hits, %u renders, %u fallbacks\n",
+                tc.slots, tc.hits, tc.renders, tc.fallbacks);
+ #endif
+         stat_pending = false;
+     }
+ }
+ 
+ /* Objects in the tree under obj, obj included */
+ static uint32_t count_objs(lv_obj_t *obj)
+ {
+     uint32_t n = 1;
+ 
+     for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) {
+         n += count_objs(lv_obj_get_child(obj, i));
+     }
+     return n;
+ }
+ #endif /* CONFIG_2048_UI_STATS */
  
  /**
   * @brief Get the background color for a tile of value v.
@@ -46,75 +138,380 @@
             : lv_color_hex(0xF9F6F2);
  }
  
+ /* Map a tile value to its tile_styles[] index */
+ static int tile_style_index(int v)
+ {
+     int e = 0;
+ 
+     while (v > 1) {
+         v >>= 1;
+         e++;
+     }
+     return e < TILE_STYLE_COUNT - 1 ? e : TILE_STYLE_COUNT - 1;
+ }
+ 
+ /* Build the shared styles from the palette */
+ static void init_styles(void)
+ {
+     lv_style_init(&cell_style);
+     lv_style_set_radius(&cell_style, 5);
+     lv_style_set_border_width(&cell_style, 0);
+ 
+     lv_style_init(&label_style);
+     lv_style_set_text_align(&label_style, LV_TEXT_ALIGN_CENTER);
+ 
+     /* text color is inherited by the cell's label */
+     for (int i = 0; i < TILE_STYLE_COUNT; i++) {
+         int v = i ? (1 << i) : 0;
+         lv_style_init(&tile_styles[i]);
+         lv_style_set_bg_color(&tile_styles[i], get_bg_color(v));
+         /* image cells have no theme background of their own */
+         lv_style_set_bg_opa(&tile_styles[i], LV_OPA_COVER);
+         lv_style_set_text_color(&tile_styles[i], get_text_color(v));
+     }
+ }
+ 
  /**
-  * @brief Create and lay out the 4×4 grid of cells.
+  * @brief Create and lay out the grid_size × grid_size grid of cells.
   */
  void create_board(lv_obj_t *parent)
  {
+     static bool styles_ready;
      lv_disp_t *disp = lv_disp_get_default();
      int scr_w = lv_disp_get_hor_res(disp);
      int scr_h = lv_disp_get_ver_res(disp);
      int board_w = (int)(scr_w * BOARD_SCALE);
      int board_h = (int)(scr_h * BOARD_SCALE);
-     int cell_w = (board_w - (GRID_SIZE + 1) * CELL_MARGIN) / GRID_SIZE;
-     int cell_h = (board_h - (GRID_SIZE + 1) * CELL_MARGIN) / GRID_SIZE;
+     int n = grid_size;
+     int cell_w = (board_w - (n + 1) * CELL_MARGIN) / n;
+     int cell_h = (board_h - (n + 1) * CELL_MARGIN) / n;
+ 
+     if (!styles_ready) {
+         init_styles();
+ #ifdef CONFIG_2048_UI_STATS
+         lv_display_add_event_cb(disp, invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+         lv_display_add_event_cb(disp, refr_start_cb, LV_EVENT_REFR_START, NULL);
+         lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+ #endif
+         styles_ready = true;
+     }
+ 
+     /* size-dependent style properties, set before any cell uses them */
+     lv_style_set_text_font(&label_style,
+                            cell_h < SMALL_FONT_CELL_H ? &lv_font_montserrat_14
+                                                       : &lv_font_montserrat_22);
  
      /* board background */
-     lv_obj_t *board = lv_obj_create(parent);
+     board = lv_obj_create(parent);
      lv_obj_set_size(board, board_w, board_h);
      lv_obj_center(board);
      lv_obj_set_style_bg_color(board, lv_color_hex(0xBBADA0), 0);
      lv_obj_set_style_radius(board, 10, 0);
      lv_obj_set_style_pad_all(board, 0, 0);
+     lv_obj_add_flag(board, LV_OBJ_FLAG_EVENT_BUBBLE);
+     /* keep the edge buttons, created once, above a re-created board */
+     lv_obj_move_background(board);
+ #ifdef CONFIG_2048_TILE_CACHE
+     tile_cache_init(board, cell_w, cell_h);
+ #endif
  
      /* create each cell */
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = 0; c < GRID_SIZE; c++) {
-             lv_obj_t *cell = lv_obj_create(board);
+     for (int r = 0; r < n; r++) {
+         for (int c = 0; c < n; c++) {
+ #ifdef CONFIG_2048_TILE_CACHE
+             /* one image per cell; styled and labeled only on a cache miss */
+             lv_obj_t *cell = lv_image_create(board);
              lv_obj_set_size(cell, cell_w, cell_h);
+             lv_obj_add_style(cell, &cell_style, 0);
+             /* fallback label, created once and shown only on a miss */
+             lv_obj_t *lbl = lv_label_create(cell);
+             lv_obj_add_style(lbl, &label_style, 0);
+             lv_obj_center(lbl);
+             lv_obj_add_flag(lbl, LV_OBJ_FLAG_HIDDEN);
+ #ifdef CONFIG_2048_ANIM
+             /* merge / spawn pops resize the cell; the bitmap follows */
+             lv_image_set_inner_align(cell, LV_IMAGE_ALIGN_STRETCH);
+ #endif
+             lv_obj_set_user_data(cell, (void *)(intptr_t)-1);
+             cached[r][c] = false;
+ #else
+             lv_obj_t *cell = create_tile(board, cell_w, cell_h);
+ #endif
              lv_obj_set_pos(cell,
                  CELL_MARGIN + c * (cell_w + CELL_MARGIN),
                  CELL_MARGIN + r * (cell_h + CELL_MARGIN));
-             lv_obj_set_style_bg_color(cell, get_bg_color(0), 0);
-             lv_obj_set_style_radius(cell, 5, 0);
-             lv_obj_set_style_border_width(cell, 0, 0);
+             /* let presses reach the screen (long-press handler) */
+             lv_obj_add_flag(cell, LV_OBJ_FLAG_EVENT_BUBBLE);
  
-             /* label in center */
-             lv_obj_t *lbl = lv_label_create(cell);
-             lv_obj_set_style_text_align(lbl, LV_TEXT_ALIGN_CENTER, 0);
-             lv_obj_set_style_text_font(lbl, &lv_font_montserrat_22, 0);
-             lv_obj_center(lbl);
+             cells[r][c] = cell;
+             shown[r][c] = -1;
+         }
+     }
+ 
+ #ifdef CONFIG_2048_AI
+     /* hint arrow, hidden until show_hint() */
+     hint_label = lv_label_create(parent);
+     lv_obj_set_style_text_font(hint_label, &lv_font_montserrat_22, 0);
+     lv_obj_set_style_text_color(hint_label, lv_color_hex(0xF9F6F2), 0);
+     lv_obj_set_style_bg_color(hint_label, lv_color_hex(0x776E65), 0);
+     lv_obj_set_style_bg_opa(hint_label, LV_OPA_80, 0);
+     lv_obj_set_style_radius(hint_label, 8, 0);
+     lv_obj_set_style_pad_all(hint_label, 10, 0);
+     lv_obj_center(hint_label);
+     lv_obj_add_flag(hint_label, LV_OBJ_FLAG_HIDDEN);
+ #endif
+ #ifdef CONFIG_2048_UI_STATS
+     struct sys_memory_stats heap;
+
+     lvgl_heap_stats(&heap);
+     printk("ui: %dx%d board uses %u objects, LVGL heap %u used (max %u)\n", n, n,
+            count_objs(board), (unsigned int)heap.allocated_bytes,
+            (unsigned int)heap.max_allocated_bytes);
+ #endif
+ }
+ 
+ /**
+  * @brief Delete the board, its cells and everything else drawn on it.
+  */
+ void destroy_board(void)
+ {
+     if (!board) {
+         return;
+     }
+     lv_obj_delete(board);
+     board = NULL;
+ #ifdef CONFIG_2048_AI
+     lv_obj_delete(hint_label);
+     hint_label = NULL;
+ #endif
+ }
+ 
+ /* Size button of the start menu: ask main() for a new game */
+ static void size_btn_event_cb(lv_event_t *e)
+ {
+     size_request = (int)(intptr_t)lv_event_get_user_data(e);
+     move_queue_wake();
+ }
+ 
+ /**
+  * @brief Show the board size picker over the screen.
+  */
+ void create_size_menu(lv_obj_t *parent, const char *title)
+ {
+     char buf[8];
+ 
+     destroy_size_menu();
+     size_menu = lv_obj_create(parent);
+     lv_obj_set_size(size_menu, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+     lv_obj_center(size_menu);
+     lv_obj_set_flex_flow(size_menu, LV_FLEX_FLOW_ROW_WRAP);
+     lv_obj_set_style_max_width(size_menu, lv_pct(80), 0);
+     lv_obj_set_style_bg_color(size_menu, lv_color_hex(0xFAF8EF), 0);
+     lv_obj_set_style_bg_opa(size_menu, LV_OPA_90, 0);
+ 
+     lv_obj_t *lbl = lv_label_create(size_menu);
+     lv_label_set_text(lbl, title);
+     lv_obj_set_style_text_font(lbl, &lv_font_montserrat_22, 0);
+     lv_obj_set_width(lbl, lv_pct(100));
+     lv_obj_set_style_text_align(lbl, LV_TEXT_ALIGN_CENTER, 0);
+ 
+     for (int n = GRID_MIN; n <= GRID_MAX; n++) {
+         lv_obj_t *btn = lv_btn_create(size_menu);
+         lv_obj_set_style_bg_color(btn, get_bg_color(1 << (n - 1)), 0);
+         lv_obj_add_event_cb(btn, size_btn_event_cb, LV_EVENT_CLICKED, (void *)(intptr_t)n);
+         lbl = lv_label_create(btn);
+         snprintf(buf, sizeof(buf), "%dx%d", n, n);
+         lv_label_set_text(lbl, buf);
+         lv_obj_set_style_text_color(lbl, get_text_color(1 << (n - 1)), 0);
+     }
+ }
+ 
+ /**
+  * @brief Remove the board size picker, if shown.
+  */
+ void destroy_size_menu(void)
+ {
+     if (size_menu) {
+         lv_obj_delete(size_menu);
+         size_menu = NULL;
+     }
+ }
+ 
+ /**
+  * @brief Create a tile showing value 0: a styled cell with a centered label.
+  */
+ lv_obj_t *create_tile(lv_obj_t *parent, int w, int h)
+ {
+     lv_obj_t *tile = lv_obj_create(parent);
+     lv_obj_set_size(tile, w, h);
+     lv_obj_add_style(tile, &cell_style, 0);
+     lv_obj_add_style(tile, &tile_styles[0], 0);
+     lv_obj_set_user_data(tile, (void *)(intptr_t)0);
+ 
+     /* label in center */
+     lv_obj_t *lbl = lv_label_create(tile);
+     lv_obj_add_style(lbl, &label_style, 0);
+     lv_obj_center(lbl);
+ 
+     return tile;
+ }
+ 
+ /**
+  * @brief Show value v on a tile created by create_tile().
+  */
+ void set_tile_value(lv_obj_t *tile, int v)
+ {
+     char buf[8];
+ 
+     /* swap in the shared style for this value */
+     int old = (int)(intptr_t)lv_obj_get_user_data(tile);
+     int idx = tile_style_index(v);
+     if (idx != old) {
+         lv_obj_replace_style(tile, &tile_styles[old], &tile_styles[idx], 0);
+         lv_obj_set_user_data(tile, (void *)(intptr_t)idx);
+     }
+ 
+     /* update number or clear */
+     if (v) {
+         snprintf(buf, sizeof(buf), "%d", v);
+     } else {
+         buf[0] = '\0';
+     }
+     lv_label_set_text(lv_obj_get_child(tile, 0), buf);
+ }
+ 
+ /**
+  * @brief Get the board tile at (r, c).
+  */
+ lv_obj_t *get_cell(int r, int c)
+ {
+     return cells[r][c];
+ }
+ 
+ #ifdef CONFIG_2048_TILE_CACHE
+ 
+ /*
+  * Blit the cached bitmap of v into an image cell. If every cache slot is
+  * pinned by other values, draw the cell like a regular tile instead: the
+  * tile style is added and the cell's hidden label shown until the value
+  * is cached again, so a miss creates no LVGL objects.
+  */
+ static void paint_image_cell(int r, int c, int v)
+ {
+     lv_obj_t *cell = cells[r][c];
+     int idx = (int)(intptr_t)lv_obj_get_user_data(cell);
+     const lv_draw_buf_t *img;
+ 
+     if (cached[r][c]) {
+         tile_cache_release(shown[r][c]);
+     }
+     shown[r][c] = v;
+     img = tile_cache_acquire(v);
+     cached[r][c] = img != NULL;
  
-             cells[r][c] = lbl;
+     if (img) {
+         if (idx >= 0) {
+             lv_obj_add_flag(lv_obj_get_child(cell, 0), LV_OBJ_FLAG_HIDDEN);
+             lv_obj_remove_style(cell, &tile_styles[idx], 0);
+             lv_obj_set_user_data(cell, (void *)(intptr_t)-1);
          }
+         lv_image_set_src(cell, img);
+         return;
+     }
+ 
+     lv_image_set_src(cell, NULL);
+     if (idx < 0) {
+         lv_obj_add_style(cell, &tile_styles[0], 0);
+         lv_obj_set_user_data(cell, (void *)(intptr_t)0);
+         lv_obj_remove_flag(lv_obj_get_child(cell, 0), LV_OBJ_FLAG_HIDDEN);
+     }
+     set_tile_value(cell, v);
+ }
+ 
+ #endif /* CONFIG_2048_TILE_CACHE */
+ 
+ /**
+  * @brief Show value v in the board cell at (r, c).
+  */
+ void paint_cell(int r, int c, int v)
+ {
+ #ifdef CONFIG_2048_UI_DIFF
+     /* unchanged cells keep their styles, text and screen area */
+     if (v == shown[r][c]) {
+         return;
      }
+ #endif
+ #ifdef CONFIG_2048_UI_STATS
+     stat_cells++;
+ #endif
+ #ifdef CONFIG_2048_TILE_CACHE
+     paint_image_cell(r, c, v);
+ #else
+     shown[r][c] = v;
+     set_tile_value(cells[r][c], v);
+ #endif
  }
  
  /**
-  * @brief Refresh all cell labels and backgrounds from the game state.
+  * @brief Refresh changed cell labels and backgrounds from the game state.
   */
  void update_ui(void)
  {
-     char buf[8];
+ #ifdef CONFIG_2048_UI_STATS
+     stat_cells = 0;
+     stat_px = 0;
+     stat_pending = true;
+ #endif
+ 
+     for (int r = 0; r < grid_size; r++) {
+         for (int c = 0; c < grid_size; c++) {
+             paint_cell(r, c, grid[r][c]);
+         }
+     }
+ }
+ 
+ /**
+  * @brief Refresh the cells in mask from the game state.
+  */
+ void update_cells(uint64_t mask)
+ {
+ #ifdef CONFIG_2048_UI_STATS
+     stat_cells = 0;
+     stat_px = 0;
+     stat_pending = true;
+ #endif
  
-     for (int r = 0; r < GRID_SIZE; r++) {
-         for (int c = 0; c < GRID_SIZE; c++) {
-             int v = grid[r][c];
-             lv_obj_t *lbl  = cells[r][c];
-             lv_obj_t *cell = lv_obj_get_parent(lbl);
- 
-             /* update background and text color */
-             lv_obj_set_style_bg_color(cell, get_bg_color(v), 0);
-             lv_obj_set_style_text_color(lbl, get_text_color(v), 0);
- 
-             /* update number or clear */
-             if (v) {
-                 snprintf(buf, sizeof(buf), "%d", v);
-             } else {
-                 buf[0] = '\0';
-             }
-             lv_label_set_text(lbl, buf);
+     while (mask) {
+         int i = __builtin_ctzll(mask);
+         int r = i / GRID_MAX, c = i % GRID_MAX;
+ 
+         mask &= mask - 1;
+         if (r < grid_size && c < grid_size) {
+             paint_cell(r, c, grid[r][c]);
          }
      }
  }
- 
\ No newline at end of file
+ 
+ #ifdef CONFIG_2048_AI
+ 
+ /**
+  * @brief Show an arrow for the suggested move over the board.
+  */
+ void show_hint(enum move_dir dir)
+ {
+     if (!hint_label) {
+         return;
+     }
+     switch (dir) {
+     case MOVE_LEFT:  lv_label_set_text(hint_label, LV_SYMBOL_LEFT);  break;
+     case MOVE_UP:    lv_label_set_text(hint_label, LV_SYMBOL_UP);    break;
+     case MOVE_RIGHT: lv_label_set_text(hint_label, LV_SYMBOL_RIGHT); break;
+     case MOVE_DOWN:  lv_label_set_text(hint_label, LV_SYMBOL_DOWN);  break;
+     default:
+         lv_obj_add_flag(hint_label, LV_OBJ_FLAG_HIDDEN);
+         return;
+     }
+     lv_obj_clear_flag(hint_label, LV_OBJ_FLAG_HIDDEN);
+ }
+ 
+ #endif /* CONFIG_2048_AI */
@@ -0,0 +1,191 @@
+/* tools/bb_equiv.c
+ *
+ * Host-side equivalence test of the packed bitboard engine (src/bitboard.c)
+ * against the firmware's grid[][] engine (src/game.c) on 4×4 boards.
+ *
+ * Every 16-bit row goes through every direction, laid out both as rows and
+ * as columns, then random boards go through every move, can_move() and
+ * spawn_tile(). For each move the boards, the "moved" result, the score
+ * gained and game.c's grid_occupied mask must agree. Run it after touching
+ * either move engine.
+ *
+ * Build from the 2048/ directory:
+ *     gcc -O2 -I inc -I tools/host -o bb_equiv tools/bb_equiv.c src/game.c src/bitboard.c
+ *
+ * Usage:
+ *     bb_equiv [boards] [seed]
+ *
+ * Exits with status 1 on the first mismatches (up to 10 are printed).
+ * Boards with two 32768 tiles in a row or column are skipped: a nibble
+ * cannot hold 65536, so the packed engine never merges them.
+ */
+
+#include "bitboard.h"
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Mismatches printed before giving up */
+#define MAX_REPORTS 10
+
+static const char *const dir_names[] = { "none", "left", "up", "right", "down" };
+
+static uint64_t test_rng = 88172645463325252ULL;
+static unsigned long mismatches;
+
+uint32_t sys_rand32_get(void)
+{
+    return 1;
+}
+
+static uint32_t rand32(void)
+{
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 7;
+    test_rng ^= test_rng << 17;
+    return (uint32_t)(test_rng >> 32);
+}
+
+/* Same xorshift32 step as game.c's spawn generator */
+static uint32_t xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+static void report(const char *what, bb_board_t b, enum move_dir dir)
+{
+    if (++mismatches <= MAX_REPORTS) {
+        printf("mismatch: %s on %016llx, %s\n", what, (unsigned long long)b, dir_names[dir]);
+    }
+}
+
+/* Load b into grid[][] the way the firmware sees it */
+static void load(bb_board_t b)
+{
+    bb_to_grid(b, grid);
+    grid_changed();
+    game_score = 0;
+}
+
+/* One move through both engines */
+static void check_move(bb_board_t b, enum move_dir dir)
+{
+    bb_board_t want = bb_move(b, dir);
+
+    load(b);
+    bool moved = move_tiles(dir);
+    uint64_t occ = grid_occupied;
+
+    if (bb_from_grid(grid) != want) {
+        report("board", b, dir);
+    }
+    if (moved != (want != b)) {
+        report("moved", b, dir);
+    }
+    if (game_score != bb_score(want) - bb_score(b)) {
+        report("score", b, dir);
+    }
+    grid_changed();
+    if (grid_occupied != occ) {
+        report("grid_occupied", b, dir);
+    }
+}
+
+static void check_board(bb_board_t b)
+{
+    for (int dir = MOVE_LEFT; dir <= MOVE_DOWN; dir++) {
+        check_move(b, (enum move_dir)dir);
+    }
+    load(b);
+    if (can_move() != bb_can_move(b)) {
+        report("can_move", b, MOVE_NONE);
+    }
+}
+
+/* Does some row or column of b hold two 32768 tiles? */
+static bool has_max_pair(bb_board_t b)
+{
+    for (int i = 0; i < 4; i++) {
+        int in_row = 0, in_col = 0;
+        for (int j = 0; j < 4; j++) {
+            in_row += bb_get_exp(b, i, j) == BB_MAX_EXP;
+            in_col += bb_get_exp(b, j, i) == BB_MAX_EXP;
+        }
+        if (in_row >= 2 || in_col >= 2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Random board: exponents mostly small so that merges are common */
+static bb_board_t random_board(void)
+{
+    bool full = rand32() % 4 == 0;
+    bb_board_t b = 0;
+
+    for (int i = 0; i < 16; i++) {
+        uint32_t r = rand32();
+        uint64_t e;
+        if (!full && r % 3 == 0) {
+            e = 0;
+        } else if (r % 16 == 1) {
+            e = 1 + (r >> 8) % (BB_MAX_EXP - 1);
+        } else {
+            e = 1 + (r >> 8) % 5;
+        }
+        b |= e << (4 * i);
+    }
+    return b;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long boards = argc > 1 ? strtoul(argv[1], NULL, 0) : 2000000;
+    unsigned long skipped = 0;
+
+    if (argc > 2) {
+        test_rng = strtoull(argv[2], NULL, 0) | 1;
+    }
+    bb_init();
+    set_grid_size(4);
+
+    /* every row, as four equal rows and as four equal columns */
+    for (uint32_t row = 0; row <= 0xFFFF; row++) {
+        bb_board_t b = row * 0x0001000100010001ULL;
+        if (has_max_pair(b)) {
+            skipped++;
+            continue;
+        }
+        check_board(b);
+        check_board(bb_transpose(b));
+    }
+
+    for (unsigned long i = 0; i < boards; i++) {
+        bb_board_t b = random_board();
+        if (has_max_pair(b)) {
+            skipped++;
+            continue;
+        }
+        check_board(b);
+
+        /* the same two random words place the same tile */
+        uint32_t seed = rand32() | 1, s = seed;
+        uint32_t pos = xorshift32(&s), val = xorshift32(&s);
+        load(b);
+        game_rng_state = seed;
+        spawn_tile();
+        if (bb_from_grid(grid) != bb_spawn_tile(b, pos, val)) {
+            report("spawn_tile", b, MOVE_NONE);
+        }
+    }
+
+    printf("bb_equiv: 65536 rows, %lu random boards, %lu skipped, %lu mismatches\n", boards,
+           skipped, mismatches);
+    return mismatches ? 1 : 0;
+}
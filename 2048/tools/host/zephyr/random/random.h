@@ -0,0 +1,15 @@
+/* tools/host/zephyr/random/random.h
+ *
+ * Host stand-in for the Zephyr random API used by src/game.c. The host
+ * tool linking game.c defines sys_rand32_get(), typically as a seeded
+ * generator so games are reproducible. Not used by the firmware build.
+ */
+
+#ifndef HOST_ZEPHYR_RANDOM_H
+#define HOST_ZEPHYR_RANDOM_H
+
+#include <stdint.h>
+
+uint32_t sys_rand32_get(void);
+
+#endif /* HOST_ZEPHYR_RANDOM_H */
@@ -0,0 +1,13 @@
+/* tools/host/zephyr/toolchain.h
+ *
+ * Host stand-in for the Zephyr toolchain macros used by src/game.c, for
+ * the host tools in tools/. Not used by the firmware build.
+ */
+
+#ifndef HOST_ZEPHYR_TOOLCHAIN_H
+#define HOST_ZEPHYR_TOOLCHAIN_H
+
+#define ALWAYS_INLINE      inline __attribute__((always_inline))
+#define BUILD_ASSERT(c, m) _Static_assert(c, m)
+
+#endif /* HOST_ZEPHYR_TOOLCHAIN_H */
@@ -0,0 +1,415 @@
+/* tools/ntuple_train.c
+ *
+ * Host-side trainer for the 2048 N-tuple evaluator.
+ *
+ * Learns afterstate values by TD(0) self-play on the packed bitboard
+ * (same move and spawn rules as src/game.c), quantizes them to the int16
+ * blob format of inc/ntuple.h, and plays the 1-ply greedy player from
+ * src/ntuple.c against random and heuristic baselines.
+ *
+ * Build from the 2048/ directory:
+ *     gcc -O2 -I inc -o ntuple_train tools/ntuple_train.c src/bitboard.c src/ntuple.c -lm
+ *
+ * Usage:
+ *     ntuple_train train <preset> <games> <out.bin> [seed]
+ *     ntuple_train eval  <in.bin> <games> [seed]
+ *     ntuple_train sweep <games> [seed]
+ *
+ * "sweep" trains every preset and prints table size against average score,
+ * to pick the flash/RAM trade-off. The firmware blob is data/ntuple_weights.bin.
+ */
+
+#include "bitboard.h"
+#include "ntuple.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Games played by the greedy player after training, for the report */
+#define EVAL_GAMES   1000
+/* Learning rate, spread over all tuple lookups of one board */
+#define ALPHA        0.1f
+
+struct preset {
+    const char *name;
+    uint8_t n_tuples;
+    uint8_t tuple_len;
+    uint8_t alphabet;
+    uint8_t cells[NTUPLE_MAX_TUPLES][NTUPLE_MAX_LEN];
+};
+
+/* Cells are r*4 + c. Each tuple also covers its seven symmetric copies. */
+static const struct preset presets[] = {
+    { "line2-a12",   2, 4, 12, { {0, 1, 2, 3}, {4, 5, 6, 7} } },
+    { "line2-a16",   2, 4, 16, { {0, 1, 2, 3}, {4, 5, 6, 7} } },
+    { "line2sq2-a12", 4, 4, 12, { {0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 4, 5}, {1, 2, 5, 6} } },
+    { "line2sq2-a16", 4, 4, 16, { {0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 4, 5}, {1, 2, 5, 6} } },
+    { "line2sq3-a14", 5, 4, 14, { {0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 4, 5}, {1, 2, 5, 6},
+                                  {5, 6, 9, 10} } },
+};
+
+#define N_PRESETS (sizeof(presets) / sizeof(presets[0]))
+
+/* ─── RNG ───────────────────────────────────────────────────────────────── */
+
+static uint64_t rng_state = 88172645463325252ULL;
+
+static uint32_t rng_next(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static bb_board_t spawn(bb_board_t b)
+{
+    uint32_t pos = rng_next();
+    return bb_spawn_tile(b, pos, rng_next());
+}
+
+/* ─── Training ──────────────────────────────────────────────────────────── */
+
+struct trainer {
+    struct ntuple_net net; /* for cell shifts and, after export, for play */
+    uint8_t *blob;
+    size_t blob_size;
+    float *w;              /* n_tuples * table_size float weights */
+};
+
+static float value(const struct trainer *tr, bb_board_t b)
+{
+    float v = 0.0f;
+
+    for (int t = 0; t < tr->net.hdr->n_tuples; t++) {
+        const float *w = tr->w + (size_t)t * tr->net.table_size;
+        for (int s = 0; s < 8; s++) {
+            v += w[ntuple_index(&tr->net, t, s, b)];
+        }
+    }
+    return v;
+}
+
+static void update(struct trainer *tr, bb_board_t b, float delta)
+{
+    for (int t = 0; t < tr->net.hdr->n_tuples; t++) {
+        float *w = tr->w + (size_t)t * tr->net.table_size;
+        for (int s = 0; s < 8; s++) {
+            w[ntuple_index(&tr->net, t, s, b)] += delta;
+        }
+    }
+}
+
+static int trainer_init(struct trainer *tr, const struct preset *p)
+{
+    struct ntuple_header hdr;
+    uint32_t table_size = 1;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = NTUPLE_MAGIC;
+    hdr.version = NTUPLE_VERSION;
+    hdr.n_tuples = p->n_tuples;
+    hdr.tuple_len = p->tuple_len;
+    hdr.alphabet = p->alphabet;
+    memcpy(hdr.cells, p->cells, sizeof(hdr.cells));
+    for (int i = 0; i < p->tuple_len; i++) {
+        table_size *= p->alphabet;
+    }
+
+    tr->blob_size = sizeof(hdr) + (size_t)p->n_tuples * table_size * sizeof(int16_t);
+    tr->blob = calloc(1, tr->blob_size);
+    tr->w = calloc((size_t)p->n_tuples * table_size, sizeof(float));
+    if (!tr->blob || !tr->w) {
+        return -1;
+    }
+    memcpy(tr->blob, &hdr, sizeof(hdr));
+    return ntuple_load(tr->blob, tr->blob_size, &tr->net);
+}
+
+static void trainer_free(struct trainer *tr)
+{
+    free(tr->blob);
+    free(tr->w);
+}
+
+/* One self-play game with TD(0) updates on afterstates; returns the score */
+static uint32_t train_game(struct trainer *tr, float alpha)
+{
+    bb_board_t b = spawn(spawn(0));
+    bb_board_t prev_after = 0;
+    bool have_prev = false;
+    uint32_t score = 0;
+
+    for (;;) {
+        bb_board_t best_after = 0;
+        float best = -INFINITY;
+        uint32_t best_r = 0;
+        uint32_t base = bb_score(b);
+
+        for (int d = MOVE_LEFT; d <= MOVE_DOWN; d++) {
+            bb_board_t nb = bb_move(b, (enum move_dir)d);
+            if (nb == b) {
+                continue;
+            }
+            uint32_t r = bb_score(nb) - base;
+            float v = (float)r + value(tr, nb);
+            if (v > best) {
+                best = v;
+                best_after = nb;
+                best_r = r;
+            }
+        }
+
+        if (best == -INFINITY) {
+            /* Terminal: the last afterstate is worth nothing */
+            if (have_prev) {
+                update(tr, prev_after, alpha * (0.0f - value(tr, prev_after)));
+            }
+            return score;
+        }
+
+        if (have_prev) {
+            float target = (float)best_r + value(tr, best_after);
+            update(tr, prev_after, alpha * (target - value(tr, prev_after)));
+        }
+        prev_after = best_after;
+        have_prev = true;
+        score += best_r;
+        b = spawn(best_after);
+    }
+}
+
+/* Quantize the float weights into the blob and pick the fixed-point shift */
+static void trainer_export(struct trainer *tr)
+{
+    struct ntuple_header *hdr = (struct ntuple_header *)tr->blob;
+    size_t n = (size_t)hdr->n_tuples * tr->net.table_size;
+    int16_t *q = (int16_t *)(hdr + 1);
+    float max = 0.0f;
+    int shift = -8;
+
+    for (size_t i = 0; i < n; i++) {
+        if (fabsf(tr->w[i]) > max) {
+            max = fabsf(tr->w[i]);
+        }
+    }
+    while (shift < 8 && max / ldexpf(1.0f, shift) > 32767.0f) {
+        shift++;
+    }
+    hdr->shift = (int8_t)shift;
+    for (size_t i = 0; i < n; i++) {
+        q[i] = (int16_t)lrintf(tr->w[i] / ldexpf(1.0f, shift));
+    }
+}
+
+static void train(struct trainer *tr, const struct preset *p, long games)
+{
+    float alpha = ALPHA / (p->n_tuples * 8);
+    double sum = 0.0;
+
+    for (long g = 1; g <= games; g++) {
+        sum += train_game(tr, alpha);
+        if (g % 10000 == 0) {
+            fprintf(stderr, "%s: %ld games, avg score %.0f\n", p->name, g, sum / 10000);
+            sum = 0.0;
+        }
+    }
+    trainer_export(tr);
+}
+
+/* ─── Evaluation ────────────────────────────────────────────────────────── */
+
+enum player { PLAYER_NTUPLE, PLAYER_RANDOM, PLAYER_HEURISTIC };
+
+/* Greedy on immediate reward, then on empty cells left */
+static enum move_dir heuristic_move(bb_board_t b)
+{
+    enum move_dir best_dir = MOVE_NONE;
+    long best = -1;
+
+    for (int d = MOVE_LEFT; d <= MOVE_DOWN; d++) {
+        bb_board_t nb = bb_move(b, (enum move_dir)d);
+        if (nb == b) {
+            continue;
+        }
+        long v = (long)(bb_score(nb) - bb_score(b)) * 16 + bb_count_empty(nb);
+        if (v > best) {
+            best = v;
+            best_dir = (enum move_dir)d;
+        }
+    }
+    return best_dir;
+}
+
+static enum move_dir random_move(bb_board_t b)
+{
+    enum move_dir legal[4];
+    int n = 0;
+
+    for (int d = MOVE_LEFT; d <= MOVE_DOWN; d++) {
+        if (bb_move(b, (enum move_dir)d) != b) {
+            legal[n++] = (enum move_dir)d;
+        }
+    }
+    return n ? legal[rng_next() % n] : MOVE_NONE;
+}
+
+struct result {
+    double avg_score;
+    double rate_2048;
+    double rate_4096;
+};
+
+static struct result play(const struct ntuple_net *net, enum player who, long games)
+{
+    struct result res = {0};
+
+    for (long g = 0; g < games; g++) {
+        bb_board_t b = spawn(spawn(0));
+        uint32_t score = 0;
+        int max_exp = 0;
+
+        for (;;) {
+            enum move_dir d = who == PLAYER_NTUPLE ? ntuple_best_move(net, b)
+                            : who == PLAYER_RANDOM ? random_move(b)
+                            : heuristic_move(b);
+            if (d == MOVE_NONE) {
+                break;
+            }
+            bb_board_t nb = bb_move(b, d);
+            score += bb_score(nb) - bb_score(b);
+            b = spawn(nb);
+        }
+        for (int i = 0; i < 16; i++) {
+            int e = bb_get_exp(b, i / 4, i % 4);
+            max_exp = e > max_exp ? e : max_exp;
+        }
+        res.avg_score += score;
+        res.rate_2048 += max_exp >= 11;
+        res.rate_4096 += max_exp >= 12;
+    }
+    res.avg_score /= games;
+    res.rate_2048 /= games;
+    res.rate_4096 /= games;
+    return res;
+}
+
+static void print_result(const char *name, size_t bytes, struct result r)
+{
+    printf("%-14s %9zu %10.0f %7.1f%% %7.1f%%\n",
+           name, bytes, r.avg_score, 100.0 * r.rate_2048, 100.0 * r.rate_4096);
+}
+
+static void print_header(void)
+{
+    printf("%-14s %9s %10s %8s %8s\n", "player", "bytes", "avg score", "2048", "4096");
+}
+
+/* ─── Main ──────────────────────────────────────────────────────────────── */
+
+static const struct preset *find_preset(const char *name)
+{
+    for (size_t i = 0; i < N_PRESETS; i++) {
+        if (strcmp(presets[i].name, name) == 0) {
+            return &presets[i];
+        }
+    }
+    return NULL;
+}
+
+static int usage(void)
+{
+    fprintf(stderr,
+            "usage: ntuple_train train <preset> <games> <out.bin> [seed]\n"
+            "       ntuple_train eval  <in.bin> <games> [seed]\n"
+            "       ntuple_train sweep <games> [seed]\n"
+            "presets:");
+    for (size_t i = 0; i < N_PRESETS; i++) {
+        fprintf(stderr, " %s", presets[i].name);
+    }
+    fprintf(stderr, "\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    bb_init();
+
+    if (argc >= 5 && strcmp(argv[1], "train") == 0) {
+        const struct preset *p = find_preset(argv[2]);
+        struct trainer tr;
+        if (!p) {
+            return usage();
+        }
+        if (argc > 5) {
+            rng_state = strtoull(argv[5], NULL, 0) | 1;
+        }
+        if (trainer_init(&tr, p) != 0) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        train(&tr, p, atol(argv[3]));
+
+        FILE *f = fopen(argv[4], "wb");
+        if (!f || fwrite(tr.blob, 1, tr.blob_size, f) != tr.blob_size) {
+            fprintf(stderr, "cannot write %s\n", argv[4]);
+            return 1;
+        }
+        fclose(f);
+        print_header();
+        print_result(p->name, tr.blob_size, play(&tr.net, PLAYER_NTUPLE, EVAL_GAMES));
+        trainer_free(&tr);
+        return 0;
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "eval") == 0) {
+        FILE *f = fopen(argv[2], "rb");
+        static uint8_t buf[4 << 20];
+        struct ntuple_net net;
+        long games = atol(argv[3]);
+        if (!f) {
+            fprintf(stderr, "cannot read %s\n", argv[2]);
+            return 1;
+        }
+        size_t size = fread(buf, 1, sizeof(buf), f);
+        fclose(f);
+        if (ntuple_load(buf, size, &net) != 0) {
+            fprintf(stderr, "%s: not an N-tuple blob\n", argv[2]);
+            return 1;
+        }
+        if (argc > 4) {
+            rng_state = strtoull(argv[4], NULL, 0) | 1;
+        }
+        print_header();
+        print_result("random", 0, play(NULL, PLAYER_RANDOM, games));
+        print_result("heuristic", 0, play(NULL, PLAYER_HEURISTIC, games));
+        print_result("ntuple", size, play(&net, PLAYER_NTUPLE, games));
+        return 0;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "sweep") == 0) {
+        long games = atol(argv[2]);
+        if (argc > 3) {
+            rng_state = strtoull(argv[3], NULL, 0) | 1;
+        }
+        print_header();
+        print_result("random", 0, play(NULL, PLAYER_RANDOM, EVAL_GAMES));
+        print_result("heuristic", 0, play(NULL, PLAYER_HEURISTIC, EVAL_GAMES));
+        for (size_t i = 0; i < N_PRESETS; i++) {
+            struct trainer tr;
+            if (trainer_init(&tr, &presets[i]) != 0) {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+            }
+            train(&tr, &presets[i], games);
+            print_result(presets[i].name, tr.blob_size,
+                         play(&tr.net, PLAYER_NTUPLE, EVAL_GAMES));
+            fflush(stdout);
+            trainer_free(&tr);
+        }
+        return 0;
+    }
+
+    return usage();
+}
@@ -0,0 +1,344 @@
+/* tools/sim2048.c
+ *
+ * Host-side 2048 simulator and strategy benchmark.
+ *
+ * Plays games with the firmware's own engine (src/game.c) on every core,
+ * one game state per thread, and reports per strategy the throughput,
+ * the score distribution and how often each tile was reached. Spawns
+ * come from game.c's xorshift generator, seeded per game from the base
+ * seed and the game number, so a run is reproducible for any thread count.
+ *
+ * Build from the 2048/ directory:
+ *     gcc -O2 -pthread -DGAME_TLS=_Thread_local -I inc -I tools/host \
+ *         -o sim2048 tools/sim2048.c src/game.c src/bitboard.c src/ntuple.c -lm
+ *
+ * Usage:
+ *     sim2048 [-s strategy[,strategy...]] [-n games] [-j threads]
+ *             [-g size] [-r seed] [-w weights.bin]
+ *
+ * Strategies: random, corner, greedy, ntuple (4x4 only; weights from -w,
+ * default data/ntuple_weights.bin). Run with a fixed seed and one strategy
+ * as a throughput regression benchmark of the move kernels.
+ */
+
+#include "game.h"
+#include "bitboard.h"
+#include "ntuple.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Games a thread claims at a time */
+#define CHUNK        256
+/* Tile exponents tracked for the max-tile rates (up to 2^17) */
+#define MAX_EXP      18
+/* Most threads */
+#define MAX_THREADS  256
+
+struct strategy {
+    const char *name;
+    /* Play one move that changes the board; false if none is possible */
+    bool (*play)(void);
+    bool square4_only;
+};
+
+/* Per-thread generator for strategy choices, separate from the spawn RNG */
+static _Thread_local uint32_t strat_rng;
+/* Value sys_rand32_get() hands to the next init_game() */
+static _Thread_local uint32_t next_seed;
+
+uint32_t sys_rand32_get(void)
+{
+    return next_seed;
+}
+
+static uint32_t splitmix32(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t)(x ^ (x >> 31));
+}
+
+static uint32_t strat_rand(void)
+{
+    uint32_t x = strat_rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return strat_rng = x;
+}
+
+/* random: the four moves in random order, first that moves */
+static bool play_random(void)
+{
+    enum move_dir order[4] = { MOVE_LEFT, MOVE_UP, MOVE_RIGHT, MOVE_DOWN };
+
+    for (int i = 3; i > 0; i--) {
+        int j = strat_rand() % (i + 1);
+        enum move_dir t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (move_tiles(order[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* corner: fixed preference that keeps big tiles in the bottom-left corner */
+static bool play_corner(void)
+{
+    return move_down() || move_left() || move_right() || move_up();
+}
+
+/* greedy: one-ply search on merged points plus a bonus per empty cell */
+static bool play_greedy(void)
+{
+    static _Thread_local int saved[GRID_MAX][GRID_MAX];
+    uint64_t occ = grid_occupied;
+    uint32_t sc = game_score;
+    enum move_dir best = MOVE_NONE;
+    int64_t best_val = -1;
+
+    memcpy(saved, grid, sizeof(saved));
+    for (int dir = MOVE_LEFT; dir <= MOVE_DOWN; dir++) {
+        if (!move_tiles((enum move_dir)dir)) {
+            continue;
+        }
+        int64_t val = (int64_t)(game_score - sc) +
+                      16 * (grid_size * grid_size - __builtin_popcountll(grid_occupied));
+        if (val > best_val) {
+            best_val = val;
+            best = (enum move_dir)dir;
+        }
+        memcpy(grid, saved, sizeof(saved));
+        grid_occupied = occ;
+        game_score = sc;
+    }
+    return best != MOVE_NONE && move_tiles(best);
+}
+
+static struct ntuple_net net;
+
+/* ntuple: 1-ply greedy on the learned afterstate values */
+static bool play_ntuple(void)
+{
+    enum move_dir dir = ntuple_best_move(&net, bb_from_grid(grid));
+
+    return dir != MOVE_NONE && move_tiles(dir);
+}
+
+static const struct strategy strategies[] = {
+    { "random", play_random, false },
+    { "corner", play_corner, false },
+    { "greedy", play_greedy, false },
+    { "ntuple", play_ntuple, true },
+};
+
+struct run {
+    const struct strategy *strat;
+    int size;
+    uint32_t seed;
+    uint32_t games;
+    atomic_uint next_game;
+    uint32_t *scores;              /* indexed by game number */
+    atomic_ullong moves;
+    atomic_uint max_tile[MAX_EXP]; /* games whose largest tile is 2^i */
+};
+
+static void *worker(void *arg)
+{
+    struct run *run = arg;
+    uint64_t moves = 0;
+    uint32_t max_tile[MAX_EXP] = { 0 };
+
+    set_grid_size(run->size);
+    for (;;) {
+        uint32_t first = atomic_fetch_add(&run->next_game, CHUNK);
+        if (first >= run->games) {
+            break;
+        }
+        uint32_t last = first + CHUNK < run->games ? first + CHUNK : run->games;
+
+        for (uint32_t g = first; g < last; g++) {
+            next_seed = splitmix32(((uint64_t)run->seed << 32) | g) | 1;
+            strat_rng = splitmix32(((uint64_t)~run->seed << 32) | g) | 1;
+            init_game();
+            while (run->strat->play()) {
+                spawn_tile();
+                moves++;
+            }
+
+            int top = 0;
+            for (int r = 0; r < run->size; r++) {
+                for (int c = 0; c < run->size; c++) {
+                    top = grid[r][c] > top ? grid[r][c] : top;
+                }
+            }
+            int e = top ? __builtin_ctz((unsigned int)top) : 0;
+            max_tile[e < MAX_EXP ? e : MAX_EXP - 1]++;
+            run->scores[g] = game_score;
+        }
+    }
+
+    atomic_fetch_add(&run->moves, moves);
+    for (int i = 0; i < MAX_EXP; i++) {
+        atomic_fetch_add(&run->max_tile[i], max_tile[i]);
+    }
+    return NULL;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run_strategy(const struct strategy *strat, uint32_t games,
+                         int threads, int size, uint32_t seed)
+{
+    static pthread_t tid[MAX_THREADS];
+    static struct run run;
+
+    memset(&run, 0, sizeof(run));
+    run.strat = strat;
+    run.size = size;
+    run.seed = seed;
+    run.games = games;
+    run.scores = malloc(games * sizeof(uint32_t));
+    if (!run.scores) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    double t0 = now_s();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&tid[i], NULL, worker, &run);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tid[i], NULL);
+    }
+    double dt = now_s() - t0;
+
+    uint64_t sum = 0;
+    for (uint32_t g = 0; g < games; g++) {
+        sum += run.scores[g];
+    }
+    qsort(run.scores, games, sizeof(uint32_t), cmp_u32);
+
+    printf("%s: %u games on %dx%d, %d threads, %.2f s\n",
+           strat->name, games, size, size, threads, dt);
+    printf("  %.0f games/s, %.0f moves/s, %.1f moves/game\n", games / dt,
+           run.moves / dt, (double)run.moves / games);
+    printf("  score mean %.0f  min %u  p10 %u  p50 %u  p90 %u  p99 %u  max %u\n",
+           (double)sum / games, run.scores[0], run.scores[games / 10],
+           run.scores[games / 2], run.scores[games * 9ULL / 10],
+           run.scores[games * 99ULL / 100], run.scores[games - 1]);
+
+    /* share of games whose largest tile reached at least 2^i */
+    printf("  max tile reached:");
+    uint32_t at_least = games;
+    for (int i = 1; i < MAX_EXP && at_least; i++) {
+        if (i >= 7) {
+            printf(" %u:%.2f%%", 1U << i, 100.0 * at_least / games);
+        }
+        at_least -= run.max_tile[i];
+    }
+    printf("\n");
+    free(run.scores);
+}
+
+static const struct strategy *find_strategy(const char *name)
+{
+    for (size_t i = 0; i < sizeof(strategies) / sizeof(strategies[0]); i++) {
+        if (!strcmp(strategies[i].name, name)) {
+            return &strategies[i];
+        }
+    }
+    return NULL;
+}
+
+static int load_weights(const char *path)
+{
+    static uint16_t buf[1 << 22];  /* 8 MB, 2-byte aligned */
+    FILE *f = fopen(path, "rb");
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    size_t size = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    if (ntuple_load(buf, size, &net) != 0) {
+        fprintf(stderr, "%s: not a valid weight blob\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    char list[256] = "random,corner,greedy";
+    const char *weights = "data/ntuple_weights.bin";
+    uint32_t games = 100000;
+    uint32_t seed = 1;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int size = 4;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:n:j:g:r:w:")) != -1) {
+        switch (opt) {
+        case 's': snprintf(list, sizeof(list), "%s", optarg); break;
+        case 'n': games = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': threads = atoi(optarg); break;
+        case 'g': size = atoi(optarg); break;
+        case 'r': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'w': weights = optarg; break;
+        default:
+            fprintf(stderr, "usage: %s [-s strategy[,strategy...]] [-n games] "
+                    "[-j threads] [-g size] [-r seed] [-w weights.bin]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 1 || threads > MAX_THREADS || games == 0 ||
+        size < GRID_MIN || size > GRID_MAX) {
+        fprintf(stderr, "bad -j, -n or -g\n");
+        return 2;
+    }
+
+    bb_init();
+    for (char *name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+        const struct strategy *strat = find_strategy(name);
+
+        if (!strat) {
+            fprintf(stderr, "unknown strategy %s (random, corner, greedy, ntuple)\n", name);
+            return 2;
+        }
+        if (strat->square4_only && size != 4) {
+            fprintf(stderr, "%s: 4x4 boards only, skipped\n", name);
+            continue;
+        }
+        if (strat->play == play_ntuple && !net.hdr && load_weights(weights) != 0) {
+            return 1;
+        }
+        run_strategy(strat, games, threads, size, seed);
+    }
+    return 0;
+}
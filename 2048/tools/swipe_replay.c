@@ -0,0 +1,278 @@
+/* tools/swipe_replay.c
+ *
+ * Host-side replay of touch traces through the 2048 swipe recognizers.
+ *
+ * Feeds each recorded stroke to src/swipe.c (the CONFIG_2048_SWIPE
+ * recognizer) and to a model of LVGL 9's gesture detection, and reports
+ * for both how many strokes moved the right way, the wrong way or not at
+ * all, and how long after touch-down the move was committed.
+ *
+ * Build from the 2048/ directory:
+ *     gcc -O2 -I inc -o swipe_replay tools/swipe_replay.c src/swipe.c -lm
+ *
+ * Usage:
+ *     swipe_replay replay <trace> [commit_px min_px min_speed axis_ratio]
+ *     swipe_replay synth  <trace> <strokes> [seed]
+ *
+ * Traces are the console output of CONFIG_2048_SWIPE_TRACE, one sample per
+ * line ("swipe: D|M|U <us> <x> <y>"; other lines are ignored). Add lines
+ * "swipe: E L|U|R|D|N" to label the strokes that follow with the intended
+ * direction, N for strokes that should not move. Unlabeled strokes only
+ * count toward latency. "synth" writes labeled synthetic strokes in the
+ * same format, for tuning without hardware.
+ */
+
+#include "swipe.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* LVGL 9 defaults: LV_INDEV_DEF_GESTURE_LIMIT, _GESTURE_MIN_VELOCITY */
+#define LV_GESTURE_LIMIT     50
+#define LV_GESTURE_MIN_VEL   3
+
+/* Label of a stroke that has none */
+#define DIR_UNKNOWN          (-1)
+
+struct sample {
+    char     phase;  /* 'D', 'M' or 'U' */
+    uint32_t t_us;
+    int32_t  x, y;
+};
+
+/* LVGL's indev_gesture(): sum per-read motion, reset when it slows down */
+struct lv_gesture {
+    int32_t px, py;
+    int32_t sx, sy;
+    bool    sent;
+};
+
+static enum move_dir lv_gesture_feed(struct lv_gesture *g, const struct sample *s)
+{
+    if (s->phase == 'D') {
+        *g = (struct lv_gesture){ .px = s->x, .py = s->y };
+        return MOVE_NONE;
+    }
+    if (g->sent || s->phase == 'U') {
+        return MOVE_NONE;
+    }
+
+    int32_t vx = s->x - g->px, vy = s->y - g->py;
+    g->px = s->x;
+    g->py = s->y;
+    if (abs(vx) < LV_GESTURE_MIN_VEL && abs(vy) < LV_GESTURE_MIN_VEL) {
+        g->sx = g->sy = 0;
+    }
+    g->sx += vx;
+    g->sy += vy;
+    if (abs(g->sx) <= LV_GESTURE_LIMIT && abs(g->sy) <= LV_GESTURE_LIMIT) {
+        return MOVE_NONE;
+    }
+    g->sent = true;
+    if (abs(g->sx) > abs(g->sy)) {
+        return g->sx > 0 ? MOVE_RIGHT : MOVE_LEFT;
+    }
+    return g->sy > 0 ? MOVE_DOWN : MOVE_UP;
+}
+
+struct tally {
+    const char *name;
+    unsigned strokes, right, wrong, none;
+    unsigned committed;
+    double   latency_ms;  /* sum over committed strokes */
+    double   lead_ms;     /* sum of time before the finger lifted */
+};
+
+static void tally_stroke(struct tally *t, int label, enum move_dir dir,
+                         uint32_t t_down, uint32_t t_commit, uint32_t t_up)
+{
+    t->strokes++;
+    if (dir != MOVE_NONE) {
+        t->committed++;
+        t->latency_ms += (t_commit - t_down) / 1000.0;
+        t->lead_ms += (t_up - t_commit) / 1000.0;
+    }
+    if (label == DIR_UNKNOWN) {
+        return;
+    }
+    if ((int)dir == label) {
+        t->right++;
+    } else if (dir == MOVE_NONE) {
+        t->none++;
+    } else {
+        t->wrong++;
+    }
+}
+
+static void tally_print(const struct tally *t)
+{
+    unsigned n = t->committed ? t->committed : 1;
+
+    printf("%-10s %7u %7u %7u %7u %10.1f %10.1f\n", t->name, t->strokes,
+           t->right, t->wrong, t->none, t->latency_ms / n, t->lead_ms / n);
+}
+
+static int parse_dir(char c)
+{
+    switch (c) {
+    case 'L': return MOVE_LEFT;
+    case 'U': return MOVE_UP;
+    case 'R': return MOVE_RIGHT;
+    case 'D': return MOVE_DOWN;
+    case 'N': return MOVE_NONE;
+    default:  return DIR_UNKNOWN;
+    }
+}
+
+static int replay(const char *path, const struct swipe_params *p)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+
+    struct tally mine = { .name = "swipe" }, lvgl = { .name = "lvgl" };
+    struct swipe sw;
+    struct lv_gesture lg = { 0 };
+    enum move_dir d_mine = MOVE_NONE, d_lvgl = MOVE_NONE;
+    uint32_t t_down = 0, t_mine = 0, t_lvgl = 0;
+    int label = DIR_UNKNOWN;
+    bool in_stroke = false;
+    char line[256];
+
+    swipe_init(&sw, p);
+    while (fgets(line, sizeof(line), f)) {
+        const char *q = strstr(line, "swipe: ");
+        struct sample s;
+        char c;
+
+        if (!q) {
+            continue;
+        }
+        q += 7;
+        if (sscanf(q, "E %c", &c) == 1) {
+            label = parse_dir(c);
+            continue;
+        }
+        if (sscanf(q, "%c %u %d %d", &s.phase, &s.t_us, &s.x, &s.y) != 4) {
+            continue;
+        }
+        if (s.phase == 'D') {
+            in_stroke = true;
+            t_down = s.t_us;
+            d_mine = d_lvgl = MOVE_NONE;
+        } else if (!in_stroke) {
+            continue;
+        }
+
+        enum swipe_phase ph = s.phase == 'D' ? SWIPE_DOWN
+                            : s.phase == 'U' ? SWIPE_UP : SWIPE_MOVE;
+        enum move_dir d = swipe_feed(&sw, ph, s.x, s.y, s.t_us);
+        if (d != MOVE_NONE) {
+            d_mine = d;
+            t_mine = s.t_us;
+        }
+        d = lv_gesture_feed(&lg, &s);
+        if (d != MOVE_NONE) {
+            d_lvgl = d;
+            t_lvgl = s.t_us;
+        }
+
+        if (s.phase == 'U') {
+            tally_stroke(&mine, label, d_mine, t_down, t_mine, s.t_us);
+            tally_stroke(&lvgl, label, d_lvgl, t_down, t_lvgl, s.t_us);
+            in_stroke = false;
+        }
+    }
+    fclose(f);
+
+    printf("params: commit %u px, min %u px, %u px/s, axis ratio %u%%\n",
+           p->commit_px, p->min_px, p->min_speed, p->axis_ratio_pct);
+    printf("%-10s %7s %7s %7s %7s %10s %10s\n", "recognizer", "strokes",
+           "right", "wrong", "none", "commit ms", "lead ms");
+    tally_print(&mine);
+    tally_print(&lvgl);
+    return 0;
+}
+
+/* Uniform in [lo, hi) */
+static double urand(double lo, double hi)
+{
+    return lo + (hi - lo) * rand() / ((double)RAND_MAX + 1);
+}
+
+/*
+ * Synthetic strokes at 100 Hz: a short rest after touch-down, then motion
+ * at a random speed with an ease-in / ease-out profile and sensor noise.
+ * 80% are labeled swipes within 20 degrees of an axis; the rest are
+ * diagonals (35..55 degrees) labeled N.
+ */
+static int synth(const char *path, int strokes)
+{
+    static const char labels[] = "LURD";
+    static const double axis_deg[] = { 180, 270, 0, 90 };  /* y grows down */
+    FILE *f = fopen(path, "w");
+    uint32_t t = 1000000;
+
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    for (int i = 0; i < strokes; i++) {
+        int k = rand() % 4;
+        bool diagonal = urand(0, 1) < 0.2;
+        double dev = diagonal ? urand(35, 55) : urand(-20, 20);
+        double ang = (axis_deg[k] + (diagonal && rand() % 2 ? -dev : dev)) * M_PI / 180;
+        double len = urand(30, 160);
+        double speed = urand(200, 1500);             /* px/s */
+        int steps = (int)(len / speed * 100) + 2;
+        double x0 = urand(60, 420), y0 = urand(60, 260);
+
+        fprintf(f, "swipe: E %c\n", diagonal ? 'N' : labels[k]);
+        fprintf(f, "swipe: D %u %d %d\n", t, (int)x0, (int)y0);
+        int rest = rand() % 3;
+        for (int j = 1; j <= rest; j++) {
+            fprintf(f, "swipe: M %u %d %d\n", t + j * 10000,
+                    (int)lround(x0 + urand(-1, 1)), (int)lround(y0 + urand(-1, 1)));
+        }
+        t += rest * 10000;
+        int32_t x = (int32_t)x0, y = (int32_t)y0;
+        for (int j = 1; j <= steps; j++) {
+            double u = (double)j / steps;
+            double s = len * (u * u * (3 - 2 * u));  /* smoothstep */
+            x = (int32_t)lround(x0 + s * cos(ang) + urand(-1.5, 1.5));
+            y = (int32_t)lround(y0 + s * sin(ang) + urand(-1.5, 1.5));
+            fprintf(f, "swipe: M %u %d %d\n", t + j * 10000, x, y);
+        }
+        t += (steps + 1) * 10000;
+        fprintf(f, "swipe: U %u %d %d\n", t, x, y);
+        t += 300000;
+    }
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && !strcmp(argv[1], "replay")) {
+        /* defaults match the Kconfig defaults */
+        struct swipe_params p = { 30, 12, 300, 170 };
+        if (argc >= 7) {
+            p.commit_px = (uint16_t)atoi(argv[3]);
+            p.min_px = (uint16_t)atoi(argv[4]);
+            p.min_speed = (uint16_t)atoi(argv[5]);
+            p.axis_ratio_pct = (uint16_t)atoi(argv[6]);
+        }
+        return replay(argv[2], &p);
+    }
+    if (argc >= 4 && !strcmp(argv[1], "synth")) {
+        srand(argc >= 5 ? (unsigned)atoi(argv[4]) : 1);
+        return synth(argv[2], atoi(argv[3]));
+    }
+    fprintf(stderr,
+            "usage: %s replay <trace> [commit_px min_px min_speed axis_ratio]\n"
+            "       %s synth  <trace> <strokes> [seed]\n", argv[0], argv[0]);
+    return 2;
+}
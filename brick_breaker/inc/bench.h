@@ -0,0 +1,21 @@
+/*
+ * Boot-time benchmarks for Brick Breaker
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*
+ * Time CONFIG_BB_BENCH_STEPS steps of a synthetic ball step (move, walls,
+ * brick and paddle tests on a 5x8 layout), written in float and in
+ * Q16.16, and print cycles per step. It compares the arithmetic, not
+ * the game's world_step().
+ * Run once with CONFIG_FPU=y and once with CONFIG_FPU=n to see the cost
+ * on FPU-less configurations.
+ *
+ * Then time the game's own world_step() on 5x8, 8x12 and 10x16 brick
+ * layouts (the largest a level can have) and print cycles per step.
+ */
+void bench_run(void);
+
+#endif /* BENCH_H */
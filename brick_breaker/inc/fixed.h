@@ -0,0 +1,36 @@
+/*
+ * Q16.16 fixed-point helpers for the Brick Breaker simulation
+ *
+ * Every position and velocity in the game step is an fx_t, so the
+ * simulation is integer-only: bit-identical on host and target, and
+ * cheap on cores without an FPU.
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+typedef int32_t fx_t;
+
+#define FX_SHIFT 16
+#define FX_ONE (1 << FX_SHIFT)
+
+/* Integer pixels to fx_t and back (rounds toward -infinity) */
+#define FX_FROM_INT(i) ((fx_t)(i) * FX_ONE)
+#define FX_TO_INT(x) ((int32_t)((x) >> FX_SHIFT))
+
+/* Compile-time constant from a decimal literal, e.g. FX_CONST(2.5) */
+#define FX_CONST(f) ((fx_t)((f) * (double)FX_ONE + ((f) >= 0 ? 0.5 : -0.5)))
+
+static inline fx_t fx_mul(fx_t a, fx_t b)
+{
+    return (fx_t)(((int64_t)a * b) >> FX_SHIFT);
+}
+
+static inline fx_t fx_div(fx_t a, fx_t b)
+{
+    return (fx_t)(((int64_t)a * FX_ONE) / b);
+}
+
+#endif /* FIXED_H */
@@ -0,0 +1,87 @@
+/*
+ * Brick Breaker level packs
+ *
+ * A level pack is a flash-resident blob read in place: a header, a
+ * table of brick types (hit points and color), one offset per level,
+ * then the levels themselves. A level is its grid size followed by one
+ * 4-bit cell per brick, two per byte, low nibble first: 0 is empty and
+ * k is types[k - 1]. A full 5x8 level takes 22 bytes.
+ *
+ * Packs are built on the host from a text layout by tools/bblevel.c.
+ * The loader has no Zephyr or LVGL dependency, so the tool uses it too.
+ */
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Pack magic, "BBLV" in little-endian byte order */
+#define LEVEL_MAGIC 0x564C4242U
+#define LEVEL_VERSION 1
+
+/* Brick types a pack may define (cells are 4 bits, 0 = empty) */
+#define LEVEL_MAX_TYPES 15
+/* Largest grid a level may use */
+#define LEVEL_MAX_ROWS 10
+#define LEVEL_MAX_COLS 16
+
+/* Pack header, followed by types[n_types] and uint16_t offsets[n_levels] */
+typedef struct
+{
+    uint32_t magic;   /* LEVEL_MAGIC */
+    uint8_t version;  /* LEVEL_VERSION */
+    uint8_t n_types;  /* 1..LEVEL_MAX_TYPES */
+    uint8_t n_levels; /* at least 1 */
+    uint8_t reserved;
+} bb_level_pack_header_t;
+
+typedef struct
+{
+    uint8_t hits;    /* hits to break, 0 = unbreakable */
+    uint8_t r, g, b; /* color */
+} bb_brick_type_t;
+
+/* A validated pack; every pointer points into the blob */
+typedef struct
+{
+    const uint8_t *base;
+    const bb_brick_type_t *types;
+    int n_types;
+    int n_levels;
+} bb_level_pack_t;
+
+/* One level of a pack, still in the blob */
+typedef struct
+{
+    const bb_brick_type_t *types;
+    uint8_t rows, cols;
+    const uint8_t *cells; /* (rows * cols + 1) / 2 bytes */
+} bb_level_t;
+
+/*
+ * Validate the blob, all of its levels included, and point pack into it.
+ * A level must fit LEVEL_MAX_ROWS x LEVEL_MAX_COLS, use only defined
+ * types, and have at least one breakable brick. Returns 0 or -1.
+ */
+int level_pack_open(const void *blob, size_t size, bb_level_pack_t *pack);
+
+/* Level i of a pack opened by level_pack_open(), 0 <= i < n_levels */
+void level_pack_get(const bb_level_pack_t *pack, int i, bb_level_t *lvl);
+
+/* Type index + 1 of the brick at (r, c), 0 if the cell is empty */
+static inline int level_cell(const bb_level_t *lvl, int r, int c)
+{
+    int i = r * lvl->cols + c;
+
+    return (lvl->cells[i / 2] >> (4 * (i & 1))) & 0xF;
+}
+
+#ifdef CONFIG_BB_LEVELS
+/* The pack built into the firmware from data/levels.bin */
+extern const uint8_t level_pack_data[];
+extern const size_t level_pack_size;
+#endif
+
+#endif /* LEVEL_H */
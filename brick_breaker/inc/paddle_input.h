@@ -0,0 +1,42 @@
+/*
+ * Brick Breaker paddle input straight from the Zephyr input subsystem
+ *
+ * An input callback turns each touch report into a sample and publishes
+ * it in a lock-free latest-value triple buffer: neither side waits on
+ * the other, a reader always gets the newest complete sample, and
+ * samples the game has not read yet are simply replaced. The game reads the slot when it steps,
+ * without waiting for LVGL's input device poll and event dispatch.
+ */
+
+#ifndef PADDLE_INPUT_H
+#define PADDLE_INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+typedef struct
+{
+    uint32_t seq;   /* number of the sample, 0 before the first one */
+    uint32_t t_cyc; /* k_cycle_get_32() when it was published */
+    int16_t x, y;   /* screen px */
+    int32_t vx;     /* smoothed x velocity while pressed, px/s */
+    bool pressed;
+} paddle_sample_t;
+
+/* Copy the latest sample. Wait-free, for one reader thread. */
+void paddle_input_read(paddle_sample_t *s);
+
+/* Sleep until a new sample is published or timeout expires */
+void paddle_input_wait(k_timeout_t timeout);
+
+/*
+ * x of s extrapolated from its velocity to lead_ms after now_cyc. The
+ * extrapolation covers at most PADDLE_INPUT_MAX_LEAD_MS, so a finger that
+ * stopped without a new report does not fling the paddle away.
+ */
+int paddle_input_predict(const paddle_sample_t *s, uint32_t now_cyc, int lead_ms);
+
+#define PADDLE_INPUT_MAX_LEAD_MS 50
+
+#endif /* PADDLE_INPUT_H */
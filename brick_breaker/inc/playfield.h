@@ -0,0 +1,38 @@
+/*
+ * Brick Breaker playfield drawn by a single LVGL widget
+ *
+ * Bricks, paddle, balls and power-ups are not objects: one widget draws them from
+ * the world in its draw event, and playfield_sync() invalidates only the
+ * rectangles that changed since the last sync.
+ */
+
+#ifndef PLAYFIELD_H
+#define PLAYFIELD_H
+
+#include <lvgl.h>
+
+#include "world.h"
+
+typedef struct
+{
+    uint32_t brick_hex; /* bricks without a level type */
+    lv_color_t paddle;
+    lv_color_t ball;
+    lv_color_t powerup[POWERUP_KINDS]; /* by bb_powerup_kind_t */
+} playfield_colors_t;
+
+/*
+ * Create the playfield over the content area of parent, which must match
+ * the world's board size. The widget keeps a pointer to w and draws it.
+ */
+lv_obj_t *playfield_create(lv_obj_t *parent, const bb_world_t *w,
+                           const playfield_colors_t *colors);
+
+/*
+ * Invalidate what changed in w since the last sync: hit bricks, the
+ * paddle, and the balls and power-ups, drawn alpha (Q16.16) of the way
+ * from their previous to their current step.
+ */
+void playfield_sync(const bb_world_t *w, fx_t alpha);
+
+#endif /* PLAYFIELD_H */
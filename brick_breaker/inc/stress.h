@@ -0,0 +1,18 @@
+/*
+ * Boot-time collision stress test for Brick Breaker
+ */
+
+#ifndef STRESS_H
+#define STRESS_H
+
+/*
+ * Play CONFIG_BB_STRESS_STEPS world steps at 1x to 16x the launch speed
+ * with the paddle following the ball, and check every step for tunneling:
+ * the ball passing through a live brick or the paddle without a bounce,
+ * ending inside one, or leaving the board. Prints one line per speed.
+ * Then time the step with 1, 2, 4... and WORLD_MAX_BALLS balls and
+ * every power-up slot in use, and print the cost per step and per ball.
+ */
+void stress_run(void);
+
+#endif /* STRESS_H */
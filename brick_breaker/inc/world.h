@@ -0,0 +1,221 @@
+/*
+ * Brick Breaker simulation state
+ *
+ * Plain data updated by world_step() without any LVGL calls: brick
+ * liveness is a bitmask, brick and paddle geometry are cached rects, and
+ * each step records what changed so the UI can sync only that.
+ * world.c needs only the C library, so tools/bbsim.c runs it on the host.
+ */
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fixed.h"
+#include "level.h"
+
+/* ─── Configuration ───────────────────────────────────────────────────────── */
+
+/* Layout when no level is loaded: a full grid of one-hit bricks */
+#define BRICK_ROWS 5
+#define BRICK_COLS 8
+/* Most bricks a level can have */
+#define BRICK_COUNT (LEVEL_MAX_ROWS * LEVEL_MAX_COLS)
+#define BRICK_MARGIN 4       /* px between bricks */
+#define PADDLE_WIDTH_SCALE 4 /* board_w / paddle_w */
+#define PADDLE_HEIGHT 12     /* px */
+#define HUD_MARGIN 24        /* px below paddle for HUD */
+#define BALL_RADIUS 5        /* px */
+#define BALL_SIZE FX_FROM_INT(BALL_RADIUS * 2)
+/* Simulation steps per second */
+#ifdef CONFIG_BB_STEP_HZ
+#define WORLD_STEP_HZ CONFIG_BB_STEP_HZ
+#else
+#define WORLD_STEP_HZ 50
+#endif
+/* Launch velocity in px/s, stored per step so the speed is rate-independent */
+#define INITIAL_BALL_VX (FX_CONST(100.0) / WORLD_STEP_HZ)
+#define INITIAL_BALL_VY (FX_CONST(-125.0) / WORLD_STEP_HZ)
+#define INITIAL_LIVES 3
+#define MAX_LIVES 9
+#define BRICK_POINTS 10
+
+/* Pool sizes: every ball and power-up lives in a fixed slot */
+#ifdef CONFIG_BB_MAX_BALLS
+#define WORLD_MAX_BALLS CONFIG_BB_MAX_BALLS
+#else
+#define WORLD_MAX_BALLS 8
+#endif
+#ifdef CONFIG_BB_MAX_POWERUPS
+#define WORLD_MAX_POWERUPS CONFIG_BB_MAX_POWERUPS
+#else
+#define WORLD_MAX_POWERUPS 4
+#endif
+
+/* Power-ups: chance a broken brick drops one, size, fall speed */
+#define POWERUP_PCT 15
+#define POWERUP_W 20 /* px */
+#define POWERUP_H 8  /* px */
+#define POWERUP_VY (FX_CONST(60.0) / WORLD_STEP_HZ)
+/* How long the wide paddle lasts, and how much wider it is */
+#define WIDE_STEPS (10 * WORLD_STEP_HZ)
+#define WIDE_SCALE_PCT 150
+
+/* ─── State ───────────────────────────────────────────────────────────────── */
+
+typedef struct
+{
+    int16_t x, y, w, h; /* px, relative to the board */
+} bb_rect_t;
+
+/* What the last world_step() changed, for the UI sync stage */
+enum
+{
+    WORLD_CHANGED_BALL = 1 << 0,
+    WORLD_CHANGED_PADDLE = 1 << 1,
+    WORLD_CHANGED_SCORE = 1 << 2,
+    WORLD_CHANGED_LIVES = 1 << 3,
+    /* new level, or more bricks hit than hit[] holds: resync every brick */
+    WORLD_CHANGED_BRICKS = 1 << 4,
+    /* a power-up appeared or went: slots may have moved */
+    WORLD_CHANGED_POWERUPS = 1 << 5,
+};
+
+typedef enum
+{
+    POWERUP_MULTIBALL, /* every ball in play splits in three */
+    POWERUP_WIDE,      /* wider paddle for WIDE_STEPS */
+    POWERUP_LIFE,      /* one more life */
+    POWERUP_KINDS,
+} bb_powerup_kind_t;
+
+/* Hit bricks listed for the UI between two world_clear_changes() */
+#define WORLD_MAX_HIT 8
+
+typedef struct
+{
+    int16_t w, h; /* board size, px */
+
+    /* bricks: rows x cols grid of pitch brick_w/h + BRICK_MARGIN */
+    uint8_t rows, cols;
+    int16_t brick_w, brick_h;
+    bb_rect_t brick_rect[BRICK_COUNT];
+    uint32_t brick_alive[(BRICK_COUNT + 31) / 32];
+    /* brick types of the level (NULL: default bricks) and per brick the
+     * type index and the hits left, 0 for unbreakable bricks */
+    const bb_brick_type_t *types;
+    uint8_t brick_type[BRICK_COUNT];
+    uint8_t brick_hits[BRICK_COUNT];
+    uint16_t bricks_left; /* breakable bricks still alive */
+
+    bb_rect_t paddle;
+    int16_t paddle_base_w; /* width without the wide power-up */
+    uint16_t wide_steps;   /* steps left with the wide paddle */
+
+    /*
+     * Balls in play are slots [0, n_balls), one array per field so the
+     * step runs through them in order. Top-left corner and velocity in
+     * Q16.16 px and px per step, and the position before the last step
+     * for render interpolation. Until launch, ball 0 rests on the paddle.
+     */
+    uint8_t n_balls;
+    bool ball_launched;
+    fx_t ball_x[WORLD_MAX_BALLS], ball_y[WORLD_MAX_BALLS];
+    fx_t ball_vx[WORLD_MAX_BALLS], ball_vy[WORLD_MAX_BALLS];
+    fx_t ball_prev_x[WORLD_MAX_BALLS], ball_prev_y[WORLD_MAX_BALLS];
+
+    /* Falling power-ups in slots [0, n_powerups): top-left corner, Q16.16 */
+    uint8_t n_powerups;
+    uint8_t powerup_pct; /* drop chance per broken brick, 0 for none */
+    fx_t pu_x[WORLD_MAX_POWERUPS], pu_y[WORLD_MAX_POWERUPS];
+    fx_t pu_prev_y[WORLD_MAX_POWERUPS];
+    uint8_t pu_kind[WORLD_MAX_POWERUPS];
+    uint32_t rng; /* drops and kinds; any nonzero seed */
+
+    int score;
+    int lives;
+
+    /* changes since the last world_clear_changes() */
+    uint8_t changed;
+    uint8_t n_hit;
+    uint16_t hit[WORLD_MAX_HIT]; /* bricks damaged or broken */
+} bb_world_t;
+
+/* ─── API ─────────────────────────────────────────────────────────────────── */
+
+/* Lay out a fresh game of default bricks on a board of width x height px */
+void world_init(bb_world_t *w, int width, int height);
+
+/* Replace the bricks with those of lvl and put the ball back on the paddle */
+void world_load_level(bb_world_t *w, const bb_level_t *lvl);
+
+/* Center the paddle on board x coordinate cx (clamped to the board) */
+void world_set_paddle(bb_world_t *w, int cx);
+
+/* Launch the ball if it is still resting on the paddle */
+void world_launch(bb_world_t *w);
+
+/*
+ * Put a ball in play at top-left (x, y) with velocity (vx, vy), or
+ * return false if every slot is in use
+ */
+bool world_add_ball(bb_world_t *w, fx_t x, fx_t y, fx_t vx, fx_t vy);
+
+/* Drop a power-up of the given kind from top-left (x, y); false if full */
+bool world_add_powerup(bb_world_t *w, int x, int y, bb_powerup_kind_t kind);
+
+/* Advance the simulation by one step */
+void world_step(bb_world_t *w);
+
+/* Forget the recorded changes once the UI has shown them */
+static inline void world_clear_changes(bb_world_t *w)
+{
+    w->changed = 0;
+    w->n_hit = 0;
+}
+
+static inline bool world_brick_alive(const bb_world_t *w, int i)
+{
+    return w->brick_alive[i / 32] & (1U << (i % 32));
+}
+
+/*
+ * Color of brick i as 0xRRGGBB, default_rgb for default bricks. Damaged
+ * bricks darken with the hits they have taken.
+ */
+static inline uint32_t world_brick_rgb(const bb_world_t *w, int i, uint32_t default_rgb)
+{
+    uint32_t r = (default_rgb >> 16) & 0xFF, g = (default_rgb >> 8) & 0xFF, b = default_rgb & 0xFF;
+    uint32_t scale = 256;
+
+    if (w->types)
+    {
+        const bb_brick_type_t *t = &w->types[w->brick_type[i]];
+        r = t->r;
+        g = t->g;
+        b = t->b;
+        if (t->hits > 1)
+        {
+            scale = 128 + 128 * w->brick_hits[i] / t->hits;
+        }
+    }
+    return ((r * scale >> 8) << 16) | ((g * scale >> 8) << 8) | (b * scale >> 8);
+}
+
+static inline bool world_game_over(const bb_world_t *w)
+{
+    return w->lives <= 0;
+}
+
+/*
+ * Ball position a fraction alpha (Q16.16, 0..FX_ONE) of the way from the
+ * previous step to the current one
+ */
+static inline fx_t world_ball_lerp(fx_t prev, fx_t cur, fx_t alpha)
+{
+    return prev + fx_mul(cur - prev, alpha);
+}
+
+#endif /* WORLD_H */
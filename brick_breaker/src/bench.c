@@ -0,0 +1,278 @@
+/*
+ * Boot-time benchmarks for Brick Breaker: synthetic float vs Q16.16 step,
+ * and the game's world_step() against the brick count
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench.h"
+#include "fixed.h"
+#include "world.h"
+
+#ifdef CONFIG_BB_BENCH
+
+/* ─── Scene ───────────────────────────────────────────────────────────────── */
+
+/* Same layout as create_ui() on a 480x320 board */
+#define SCENE_W 480
+#define SCENE_H 320
+#define SCENE_ROWS 5
+#define SCENE_COLS 8
+#define SCENE_MARGIN 4
+#define SCENE_BALL 10
+#define SCENE_BRICK_W ((SCENE_W - (SCENE_COLS + 1) * SCENE_MARGIN) / SCENE_COLS)
+#define SCENE_BRICK_H ((SCENE_H / 3 - (SCENE_ROWS + 1) * SCENE_MARGIN) / SCENE_ROWS)
+#define SCENE_PADDLE_W (SCENE_W / 4)
+#define SCENE_PADDLE_Y (SCENE_H - 12 - 4 - 24)
+
+/* Bricks are never removed, so the ball keeps hitting them */
+static int brick_x[SCENE_ROWS * SCENE_COLS], brick_y[SCENE_ROWS * SCENE_COLS];
+
+static void scene_init(void)
+{
+    for (int r = 0; r < SCENE_ROWS; r++)
+    {
+        for (int c = 0; c < SCENE_COLS; c++)
+        {
+            brick_x[r * SCENE_COLS + c] = SCENE_MARGIN + c * (SCENE_BRICK_W + SCENE_MARGIN);
+            brick_y[r * SCENE_COLS + c] = SCENE_MARGIN + r * (SCENE_BRICK_H + SCENE_MARGIN);
+        }
+    }
+}
+
+/* ─── Synthetic step, float ───────────────────────────────────────────────── */
+
+/*
+ * A fixed ball step with walls, a brick scan and the paddle, written once
+ * in float and once in Q16.16. It compares the arithmetic only: it is
+ * not world_step(), which also sweeps the ball, breaks bricks and runs
+ * the pools.
+ */
+
+struct ball_f
+{
+    float x, y, vx, vy;
+};
+
+static void step_float(struct ball_f *b, int paddle_x)
+{
+    b->x += b->vx;
+    b->y += b->vy;
+
+    if (b->x <= 0)
+    {
+        b->x = 0;
+        b->vx = -b->vx;
+    }
+    if (b->x + SCENE_BALL >= SCENE_W)
+    {
+        b->x = SCENE_W - SCENE_BALL;
+        b->vx = -b->vx;
+    }
+    if (b->y <= 0)
+    {
+        b->y = 0;
+        b->vy = -b->vy;
+    }
+
+    for (int i = 0; i < SCENE_ROWS * SCENE_COLS; i++)
+    {
+        float bx = brick_x[i], by = brick_y[i];
+        if (b->x + SCENE_BALL > bx && b->x < bx + SCENE_BRICK_W &&
+            b->y + SCENE_BALL > by && b->y < by + SCENE_BRICK_H)
+        {
+            b->vy = -b->vy;
+            break;
+        }
+    }
+
+    /* the paddle covers the whole bottom, so the ball is never lost */
+    float px = paddle_x;
+    if (b->y + SCENE_BALL >= SCENE_PADDLE_Y && b->x + SCENE_BALL > px &&
+        b->x < px + SCENE_PADDLE_W)
+    {
+        b->y = SCENE_PADDLE_Y - SCENE_BALL - 1;
+        b->vy = -b->vy;
+    }
+    if (b->y + SCENE_BALL >= SCENE_H)
+    {
+        b->y = SCENE_PADDLE_Y - SCENE_BALL - 1;
+        b->vy = -b->vy;
+    }
+}
+
+/* ─── Synthetic step, Q16.16 ──────────────────────────────────────────────── */
+
+struct ball_fx
+{
+    fx_t x, y, vx, vy;
+};
+
+static void step_fixed(struct ball_fx *b, int paddle_x)
+{
+    const fx_t size = FX_FROM_INT(SCENE_BALL);
+
+    b->x += b->vx;
+    b->y += b->vy;
+
+    if (b->x <= 0)
+    {
+        b->x = 0;
+        b->vx = -b->vx;
+    }
+    if (b->x + size >= FX_FROM_INT(SCENE_W))
+    {
+        b->x = FX_FROM_INT(SCENE_W) - size;
+        b->vx = -b->vx;
+    }
+    if (b->y <= 0)
+    {
+        b->y = 0;
+        b->vy = -b->vy;
+    }
+
+    for (int i = 0; i < SCENE_ROWS * SCENE_COLS; i++)
+    {
+        fx_t bx = FX_FROM_INT(brick_x[i]), by = FX_FROM_INT(brick_y[i]);
+        if (b->x + size > bx && b->x < bx + FX_FROM_INT(SCENE_BRICK_W) &&
+            b->y + size > by && b->y < by + FX_FROM_INT(SCENE_BRICK_H))
+        {
+            b->vy = -b->vy;
+            break;
+        }
+    }
+
+    fx_t px = FX_FROM_INT(paddle_x);
+    if (b->y + size >= FX_FROM_INT(SCENE_PADDLE_Y) && b->x + size > px &&
+        b->x < px + FX_FROM_INT(SCENE_PADDLE_W))
+    {
+        b->y = FX_FROM_INT(SCENE_PADDLE_Y - SCENE_BALL - 1);
+        b->vy = -b->vy;
+    }
+    if (b->y + size >= FX_FROM_INT(SCENE_H))
+    {
+        b->y = FX_FROM_INT(SCENE_PADDLE_Y - SCENE_BALL - 1);
+        b->vy = -b->vy;
+    }
+}
+
+/* ─── world_step() vs brick count ─────────────────────────────────────────── */
+
+static bb_world_t world;
+static const bb_brick_type_t bench_type = {1, 0xC0, 0x60, 0x40};
+static uint8_t bench_cells[(BRICK_COUNT + 1) / 2];
+
+/* A rows x cols level of one-hit bricks, every third one already broken */
+static void bench_level(int rows, int cols, bb_level_t *lvl)
+{
+    memset(bench_cells, 0, sizeof(bench_cells));
+    for (int i = 0; i < rows * cols; i++)
+    {
+        if (i % 3 != 0)
+        {
+            bench_cells[i / 2] |= 1 << (4 * (i & 1));
+        }
+    }
+    *lvl = (bb_level_t){.types = &bench_type, .rows = rows, .cols = cols, .cells = bench_cells};
+}
+
+/*
+ * Cycles per world_step() on lvl, with the paddle under the first ball.
+ * The level is reloaded whenever it is cleared, so every step has
+ * bricks to hit. *broken counts the bricks broken.
+ */
+static uint32_t bench_world(const bb_level_t *lvl, uint32_t *broken)
+{
+    uint32_t cyc = 0;
+
+    world_init(&world, SCENE_W, SCENE_H);
+    world_load_level(&world, lvl);
+    for (int i = 0; i < CONFIG_BB_BENCH_STEPS; i++)
+    {
+        if (world.bricks_left == 0 || world_game_over(&world))
+        {
+            world_init(&world, SCENE_W, SCENE_H);
+            world_load_level(&world, lvl);
+        }
+        world_launch(&world);
+        world_set_paddle(&world, FX_TO_INT(world.ball_x[0]) + BALL_RADIUS);
+
+        int before = world.bricks_left;
+        uint32_t t0 = k_cycle_get_32();
+        world_step(&world);
+        cyc += k_cycle_get_32() - t0;
+        world_clear_changes(&world);
+        *broken += before - world.bricks_left;
+    }
+    return cyc / CONFIG_BB_BENCH_STEPS;
+}
+
+static void bench_bricks(void)
+{
+    static const struct
+    {
+        int rows, cols;
+    } layouts[] = {
+        {5, 8}, {8, 12}, {LEVEL_MAX_ROWS, LEVEL_MAX_COLS},
+    };
+
+    for (size_t k = 0; k < ARRAY_SIZE(layouts); k++)
+    {
+        bb_level_t lvl;
+        uint32_t broken = 0;
+
+        bench_level(layouts[k].rows, layouts[k].cols, &lvl);
+        uint32_t cyc = bench_world(&lvl, &broken);
+        printk("bench: %dx%d bricks, world_step %u cyc/step, %u bricks broken\n",
+               layouts[k].rows, layouts[k].cols, cyc, broken);
+    }
+}
+
+/* ─── Runner ──────────────────────────────────────────────────────────────── */
+
+/* Paddle sweeping back and forth, the same for both runs */
+static int paddle_at(int step)
+{
+    int span = SCENE_W - SCENE_PADDLE_W;
+    int p = (step * 3) % (2 * span);
+
+    return p < span ? p : 2 * span - p;
+}
+
+void bench_run(void)
+{
+    struct ball_f bf = {SCENE_W / 2, SCENE_PADDLE_Y - SCENE_BALL - 1, 2.0f, -2.5f};
+    struct ball_fx bx = {FX_FROM_INT(SCENE_W / 2), FX_FROM_INT(SCENE_PADDLE_Y - SCENE_BALL - 1),
+                         FX_CONST(2.0), FX_CONST(-2.5)};
+    uint32_t t0, cyc_float, cyc_fixed;
+
+    scene_init();
+
+    t0 = k_cycle_get_32();
+    for (int i = 0; i < CONFIG_BB_BENCH_STEPS; i++)
+    {
+        step_float(&bf, paddle_at(i));
+    }
+    cyc_float = k_cycle_get_32() - t0;
+
+    t0 = k_cycle_get_32();
+    for (int i = 0; i < CONFIG_BB_BENCH_STEPS; i++)
+    {
+        step_fixed(&bx, paddle_at(i));
+    }
+    cyc_fixed = k_cycle_get_32() - t0;
+
+    printk("bench: %d synthetic steps, float %u cyc/step, Q16.16 %u cyc/step (FPU %s)\n",
+           CONFIG_BB_BENCH_STEPS, cyc_float / CONFIG_BB_BENCH_STEPS,
+           cyc_fixed / CONFIG_BB_BENCH_STEPS, IS_ENABLED(CONFIG_FPU) ? "on" : "off");
+    /* printing both end states also keeps either loop from being optimized out */
+    printk("bench: float ball ends at %d,%d\n", (int)bf.x, (int)bf.y);
+    /* the fixed-point end state is the same on every build and target */
+    printk("bench: Q16.16 ball ends at %08x,%08x\n", (uint32_t)bx.x, (uint32_t)bx.y);
+
+    bench_bricks();
+}
+
+#endif /* CONFIG_BB_BENCH */
@@ -0,0 +1,85 @@
+/*
+ * Brick Breaker level pack validation and lookup
+ */
+
+#include "level.h"
+
+static const uint8_t *offset_table(const bb_level_pack_t *pack)
+{
+    return (const uint8_t *)(pack->types + pack->n_types);
+}
+
+/* Offsets are little-endian uint16_t at any byte alignment */
+static size_t level_offset(const bb_level_pack_t *pack, int i)
+{
+    const uint8_t *p = offset_table(pack) + 2 * i;
+
+    return p[0] | (p[1] << 8);
+}
+
+int level_pack_open(const void *blob, size_t size, bb_level_pack_t *pack)
+{
+    const bb_level_pack_header_t *hdr = blob;
+
+    if (size < sizeof(*hdr) || hdr->magic != LEVEL_MAGIC || hdr->version != LEVEL_VERSION ||
+        hdr->n_types == 0 || hdr->n_types > LEVEL_MAX_TYPES || hdr->n_levels == 0)
+    {
+        return -1;
+    }
+    pack->base = blob;
+    pack->types = (const bb_brick_type_t *)(hdr + 1);
+    pack->n_types = hdr->n_types;
+    pack->n_levels = hdr->n_levels;
+
+    size_t tables = sizeof(*hdr) + hdr->n_types * sizeof(bb_brick_type_t) + 2 * hdr->n_levels;
+    if (size < tables)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < pack->n_levels; i++)
+    {
+        size_t off = level_offset(pack, i);
+        if (off < tables || off + 2 > size)
+        {
+            return -1;
+        }
+
+        bb_level_t lvl;
+        level_pack_get(pack, i, &lvl);
+        if (lvl.rows == 0 || lvl.rows > LEVEL_MAX_ROWS || lvl.cols == 0 ||
+            lvl.cols > LEVEL_MAX_COLS || off + 2 + (lvl.rows * lvl.cols + 1) / 2 > size)
+        {
+            return -1;
+        }
+
+        int breakable = 0;
+        for (int r = 0; r < lvl.rows; r++)
+        {
+            for (int c = 0; c < lvl.cols; c++)
+            {
+                int t = level_cell(&lvl, r, c);
+                if (t > pack->n_types)
+                {
+                    return -1;
+                }
+                breakable += t && pack->types[t - 1].hits;
+            }
+        }
+        if (!breakable)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void level_pack_get(const bb_level_pack_t *pack, int i, bb_level_t *lvl)
+{
+    const uint8_t *p = pack->base + level_offset(pack, i);
+
+    lvl->types = pack->types;
+    lvl->rows = p[0];
+    lvl->cols = p[1];
+    lvl->cells = p + 2;
+}
@@ -0,0 +1,18 @@
+/*
+ * Flash-resident level pack, generated at build time from data/levels.bin
+ * (see tools/bblevel.c)
+ */
+
+#include <zephyr/toolchain.h>
+
+#include "level.h"
+
+#ifdef CONFIG_BB_LEVELS
+
+const uint8_t level_pack_data[] __aligned(4) = {
+#include "levels.bin.inc"
+};
+
+const size_t level_pack_size = sizeof(level_pack_data);
+
+#endif /* CONFIG_BB_LEVELS */
@@ -7,19 +7,28 @@
 #include <zephyr/drivers/display.h>
 #include <zephyr/kernel.h>
 #include <lvgl.h>
+#include <string.h>
+
+#include "world.h"
+#ifdef CONFIG_BB_PLAYFIELD_WIDGET
+#include "playfield.h"
+#endif
+#if defined(CONFIG_BB_UI_STATS) || defined(CONFIG_BB_RESTART_SOAK)
+#include <lvgl_mem.h>
+#endif
+#ifdef CONFIG_BB_BENCH
+#include "bench.h"
+#endif
+#ifdef CONFIG_BB_STRESS
+#include "stress.h"
+#endif
+#if defined(CONFIG_BB_DIRECT_INPUT) || defined(CONFIG_BB_INPUT_STATS)
+#include "paddle_input.h"
+#endif
 
 /* ─── Configuration ───────────────────────────────────────────────────────── */
 
 #define BOARD_SCALE 1.0f /* fraction of screen used */
-#define BRICK_ROWS 5
-#define BRICK_COLS 8
-#define BRICK_MARGIN 4       /* px between bricks */
-#define PADDLE_WIDTH_SCALE 4 /* board_w / paddle_w */
-#define PADDLE_HEIGHT 12     /* px */
-#define HUD_MARGIN 24        /* px below paddle for HUD */
-#define BALL_RADIUS 5        /* px */
-#define INITIAL_BALL_VX 2.0f
-#define INITIAL_BALL_VY -2.5f
 
 /* ─── Theme ───────────────────────────────────────────────────────────────── */
 
@@ -29,6 +38,7 @@ typedef struct
     uint32_t brick_hex;
     uint32_t paddle_hex;
     uint32_t ball_hex;
+    uint32_t powerup_hex[POWERUP_KINDS];
     uint32_t hud_text_hex;
 } bb_theme_t;
 
@@ -37,6 +47,11 @@ static const bb_theme_t default_theme = {
     .brick_hex = 0xFF5733,
     .paddle_hex = 0x33C1FF,
     .ball_hex = 0xFFFFFF,
+    .powerup_hex = {
+        [POWERUP_MULTIBALL] = 0xFFD700,
+        [POWERUP_WIDE] = 0x7CFC00,
+        [POWERUP_LIFE] = 0xFF69B4,
+    },
     .hud_text_hex = 0xFFFFFF,
 };
 
@@ -44,31 +59,202 @@ static const bb_theme_t *theme = &default_theme;
 
 /* ─── Globals ─────────────────────────────────────────────────────────────── */
 
+/* Simulation state; the LVGL objects below only mirror it */
+static bb_world_t world;
+
 static lv_obj_t *board;
-static lv_obj_t *bricks[BRICK_ROWS][BRICK_COLS];
+#ifndef CONFIG_BB_PLAYFIELD_WIDGET
+/* Object pools, all created with the board: the frame loop only hides them */
+static lv_obj_t *bricks[BRICK_COUNT];
 static lv_obj_t *paddle;
-static lv_obj_t *ball;
+static lv_obj_t *balls[WORLD_MAX_BALLS];
+static lv_obj_t *powerups[WORLD_MAX_POWERUPS];
+static int n_brick_objs, shown_balls, shown_powerups;
+#endif
 static lv_obj_t *score_label, *lives_label;
+/* Game over box and restart button, hidden while playing */
+static lv_obj_t *over_box, *over_btn;
 
-static int score = 0;
-static int lives = 3;
+static lv_timer_t *game_timer;
 
-static float ball_x, ball_y;
-static float ball_vx, ball_vy;
-static bool ball_launched = false;
+#ifdef CONFIG_BB_LEVELS
+/* Built-in level pack, read in place from flash */
+static bb_level_pack_t levels;
+static bool levels_ok;
+static int level_index;
+#endif
 
-static lv_timer_t *game_timer;
+/*
+ * Fixed-timestep clock. step_acc counts elapsed time in units of
+ * 1 / (TICKS_PER_SEC * WORLD_STEP_HZ) s, so one step is exactly
+ * TICKS_PER_SEC units at any step rate.
+ */
+#define TICKS_PER_SEC CONFIG_SYS_CLOCK_TICKS_PER_SEC
+static int64_t last_tick;
+static uint64_t step_acc;
+/* How far the drawn ball is between the last two steps, Q16.16 */
+static fx_t render_alpha;
+
+#ifdef CONFIG_BB_STEP_STATS
+static uint32_t stat_steps, stat_catchup, stat_dropped, stat_frames;
+static int64_t stat_since;
+#endif
+
+#ifdef CONFIG_BB_UI_STATS
+/* Refreshes, render time and invalidated area since the last report */
+static uint32_t ui_refrs, ui_refr_cyc, ui_px;
+static uint32_t ui_refr_start;
+static int64_t ui_since;
+/* update_game() time: total and worst, and the most balls seen */
+static uint32_t ui_frames, ui_frame_cyc, ui_frame_max;
+static int ui_balls_max;
+
+static void invalidate_area_cb(lv_event_t *e)
+{
+    const lv_area_t *area = lv_event_get_param(e);
+    ui_px += lv_area_get_size(area);
+}
+
+static void refr_start_cb(lv_event_t *e)
+{
+    ARG_UNUSED(e);
+    ui_refr_start = k_cycle_get_32();
+}
+
+/* Every 5 s, print the mean render time and area per refresh */
+static void refr_ready_cb(lv_event_t *e)
+{
+    ARG_UNUSED(e);
+    ui_refrs++;
+    ui_refr_cyc += k_cycle_get_32() - ui_refr_start;
+    if (k_uptime_get() - ui_since < 5000)
+    {
+        return;
+    }
+    printk("ui: %u refreshes, %u us and %u px invalidated per refresh\n", ui_refrs,
+           k_cyc_to_us_floor32(ui_refr_cyc / ui_refrs), ui_px / ui_refrs);
+    if (ui_frames)
+    {
+        printk("ui: %u frames, %u us mean, %u us max, up to %d balls\n", ui_frames,
+               k_cyc_to_us_floor32(ui_frame_cyc / ui_frames), k_cyc_to_us_floor32(ui_frame_max),
+               ui_balls_max);
+    }
+    ui_refrs = ui_refr_cyc = ui_px = 0;
+    ui_frames = ui_frame_cyc = ui_frame_max = 0;
+    ui_balls_max = 0;
+    ui_since = k_uptime_get();
+}
+
+/* Objects in the tree under obj, obj included */
+static uint32_t count_objs(lv_obj_t *obj)
+{
+    uint32_t n = 1;
+
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++)
+    {
+        n += count_objs(lv_obj_get_child(obj, i));
+    }
+    return n;
+}
+#endif /* CONFIG_BB_UI_STATS */
+
+#ifdef CONFIG_BB_DIRECT_INPUT
+/* Number of the last touch sample applied to the paddle */
+static uint32_t input_seq;
+#endif
+
+#ifdef CONFIG_BB_INPUT_STATS
+/*
+ * Touch-to-paddle latency: from the publication of a touch sample to the
+ * end of the first refresh that draws the paddle moved by it
+ */
+static uint32_t lat_pending; /* cycle stamp of that sample, 0 if none */
+static uint32_t lat_n, lat_sum_us, lat_min_us, lat_max_us;
+static int64_t lat_since;
+
+static void mark_touch(uint32_t t_cyc)
+{
+    if (!lat_pending)
+    {
+        lat_pending = t_cyc ? t_cyc : 1;
+    }
+}
+
+/* Every 5 s, print the latency of the samples drawn */
+static void input_refr_ready_cb(lv_event_t *e)
+{
+    ARG_UNUSED(e);
+    if (lat_pending)
+    {
+        uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - lat_pending);
+        lat_pending = 0;
+        lat_min_us = lat_n ? MIN(lat_min_us, us) : us;
+        lat_max_us = MAX(lat_max_us, us);
+        lat_sum_us += us;
+        lat_n++;
+    }
+    if (k_uptime_get() - lat_since < 5000 || lat_n == 0)
+    {
+        return;
+    }
+    printk("input: %u paddle moves, touch-to-paddle %u / %u / %u us (min / mean / max)\n", lat_n,
+           lat_min_us, lat_sum_us / lat_n, lat_max_us);
+    lat_n = lat_sum_us = lat_max_us = 0;
+    lat_since = k_uptime_get();
+}
+#endif /* CONFIG_BB_INPUT_STATS */
 
 /* ─── Forward Declarations ────────────────────────────────────────────────── */
 
 static void create_ui(lv_obj_t *parent);
-static void reset_ball(void);
+static void new_game(void);
+static void sync_ui(void);
 static void update_game(lv_timer_t *t);
+#ifdef CONFIG_BB_DIRECT_INPUT
+static bool apply_touch(void);
+#else
 static void paddle_touch_cb(lv_event_t *e);
+#endif
 static void restart_game_cb(lv_event_t *e);
+#ifdef CONFIG_BB_LEVELS
+static void start_level(void);
+#endif
 
 /* ─── UI Creation ─────────────────────────────────────────────────────────── */
 
+#ifndef CONFIG_BB_PLAYFIELD_WIDGET
+/* A borderless, hidden pool object on the board */
+static lv_obj_t *create_rect(uint32_t hex, int radius)
+{
+    lv_obj_t *obj = lv_obj_create(board);
+
+    lv_obj_set_style_bg_color(obj, lv_color_hex(hex), 0);
+    lv_obj_set_style_border_width(obj, 0, 0);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    return obj;
+}
+
+/* Brick objects the board needs: the largest level, or the default grid */
+static int max_bricks(void)
+{
+    int n = world.rows * world.cols;
+
+#ifdef CONFIG_BB_LEVELS
+    for (int i = 0; levels_ok && i < levels.n_levels; i++)
+    {
+        bb_level_t lvl;
+        level_pack_get(&levels, i, &lvl);
+        if (lvl.rows * lvl.cols > n)
+        {
+            n = lvl.rows * lvl.cols;
+        }
+    }
+#endif
+    return n;
+}
+#endif
+
 static void create_ui(lv_obj_t *parent)
 {
     /* Screen dims */
@@ -80,6 +266,15 @@ static void create_ui(lv_obj_t *parent)
     lv_coord_t board_w = scr_w * BOARD_SCALE;
     lv_coord_t board_h = scr_h * BOARD_SCALE;
 
+    /* World laid out for this board, to size the object pools */
+    world_init(&world, board_w, board_h);
+
+#ifdef CONFIG_BB_UI_STATS
+    struct sys_memory_stats heap;
+    lvgl_heap_stats(&heap);
+    size_t heap_before = heap.allocated_bytes;
+#endif
+
     board = lv_obj_create(parent);
     lv_obj_clear_flag(board, LV_OBJ_FLAG_SCROLLABLE);
 
@@ -88,208 +283,427 @@ static void create_ui(lv_obj_t *parent)
     lv_obj_set_style_bg_color(board, lv_color_hex(theme->board_bg_hex), 0);
     lv_obj_set_style_pad_all(board, 0, 0);
 
-    /* Bricks region */
-    lv_coord_t bricks_h = board_h / 3;
-    lv_coord_t brick_h = (bricks_h - (BRICK_ROWS + 1) * BRICK_MARGIN) / BRICK_ROWS;
-    lv_coord_t brick_w = (board_w - (BRICK_COLS + 1) * BRICK_MARGIN) / BRICK_COLS;
-
-    for (int r = 0; r < BRICK_ROWS; r++)
+#ifdef CONFIG_BB_PLAYFIELD_WIDGET
+    /* Bricks, paddle, balls and power-ups, all drawn by one widget */
+    playfield_colors_t colors = {
+        .brick_hex = theme->brick_hex,
+        .paddle = lv_color_hex(theme->paddle_hex),
+        .ball = lv_color_hex(theme->ball_hex),
+    };
+    for (int k = 0; k < POWERUP_KINDS; k++)
     {
-        for (int c = 0; c < BRICK_COLS; c++)
-        {
-            lv_obj_t *b = lv_obj_create(board);
-            lv_obj_set_size(b, brick_w, brick_h);
-            lv_obj_set_style_bg_color(b, lv_color_hex(theme->brick_hex), 0);
-            lv_obj_set_style_border_width(b, 0, 0);
-            lv_coord_t x = BRICK_MARGIN + c * (brick_w + BRICK_MARGIN);
-            lv_coord_t y = BRICK_MARGIN + r * (brick_h + BRICK_MARGIN);
-            lv_obj_set_pos(b, x, y);
-            bricks[r][c] = b;
-        }
+        colors.powerup[k] = lv_color_hex(theme->powerup_hex[k]);
     }
-
-    /* Paddle */
-    lv_coord_t paddle_w = board_w / PADDLE_WIDTH_SCALE;
-    paddle = lv_obj_create(board);
-    lv_obj_set_size(paddle, paddle_w, PADDLE_HEIGHT);
-    lv_obj_set_style_bg_color(paddle, lv_color_hex(theme->paddle_hex), 0);
-    lv_obj_set_style_border_width(paddle, 0, 0);
-    lv_obj_set_style_radius(paddle, PADDLE_HEIGHT / 2, 0);
-    lv_coord_t py = board_h - PADDLE_HEIGHT - BRICK_MARGIN - HUD_MARGIN;
-    lv_obj_set_pos(paddle, (board_w - paddle_w) / 2, py);
-
-    /* Ball */
-    ball = lv_obj_create(board);
-    lv_obj_set_size(ball, BALL_RADIUS * 2, BALL_RADIUS * 2);
-    lv_obj_set_style_bg_color(ball, lv_color_hex(theme->ball_hex), 0);
-    lv_obj_set_style_radius(ball, BALL_RADIUS, 0);
-    lv_obj_set_style_border_width(ball, 0, 0);
-    reset_ball();
+    playfield_create(board, &world, &colors);
+#else
+    /* Every pool object up front, back to front: bricks, power-ups, paddle, balls */
+    n_brick_objs = max_bricks();
+    memset(bricks, 0, sizeof(bricks));
+    for (int i = 0; i < n_brick_objs; i++)
+    {
+        bricks[i] = create_rect(theme->brick_hex, 0);
+    }
+    for (int i = 0; i < WORLD_MAX_POWERUPS; i++)
+    {
+        powerups[i] = create_rect(theme->powerup_hex[0], POWERUP_H / 2);
+        lv_obj_set_size(powerups[i], POWERUP_W, POWERUP_H);
+    }
+    paddle = create_rect(theme->paddle_hex, PADDLE_HEIGHT / 2);
+    lv_obj_clear_flag(paddle, LV_OBJ_FLAG_HIDDEN);
+    for (int b = 0; b < WORLD_MAX_BALLS; b++)
+    {
+        balls[b] = create_rect(theme->ball_hex, BALL_RADIUS);
+        lv_obj_set_size(balls[b], BALL_RADIUS * 2, BALL_RADIUS * 2);
+    }
+    shown_balls = shown_powerups = 0;
+#endif
 
     /* HUD */
     score_label = lv_label_create(board);
-    lv_label_set_text_fmt(score_label, "Score: %d", score);
     lv_obj_set_style_text_color(score_label, lv_color_hex(theme->hud_text_hex), 0);
     lv_obj_set_style_text_font(score_label, &lv_font_montserrat_14, 0);
     lv_obj_align(score_label, LV_ALIGN_BOTTOM_LEFT, 8, -8);
 
     lives_label = lv_label_create(board);
-    lv_label_set_text_fmt(lives_label, "Lives: %d", lives);
     lv_obj_set_style_text_color(lives_label, lv_color_hex(theme->hud_text_hex), 0);
     lv_obj_set_style_text_font(lives_label, &lv_font_montserrat_14, 0);
     lv_obj_align(lives_label, LV_ALIGN_BOTTOM_RIGHT, -8, -8);
 
+    /* Game Over box with white border */
+    const lv_coord_t W = 200, H = 60;
+    over_box = lv_obj_create(parent);
+    lv_obj_set_size(over_box, W, H);
+    lv_obj_center(over_box);
+    lv_obj_set_style_bg_color(over_box, lv_color_hex(theme->board_bg_hex), 0);
+    lv_obj_set_style_border_width(over_box, 2, 0);
+    lv_obj_set_style_border_color(over_box, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_radius(over_box, 8, 0);
+    lv_obj_clear_flag(over_box, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *lbl = lv_label_create(over_box);
+    lv_label_set_text(lbl, "Game Over");
+    lv_obj_set_style_text_color(lbl, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_22, 0);
+    lv_obj_center(lbl);
+
+    /* Restart button below, transparent except for the icon */
+    over_btn = lv_btn_create(parent);
+    lv_obj_set_size(over_btn, 40, 40);
+    lv_obj_align(over_btn, LV_ALIGN_CENTER, 0, H / 2 + 20);
+    lv_obj_add_event_cb(over_btn, restart_game_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_set_style_bg_opa(over_btn, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_opa(over_btn, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_shadow_opa(over_btn, LV_OPA_TRANSP, 0);
+
+    lv_obj_t *icon = lv_label_create(over_btn);
+    lv_label_set_text(icon, LV_SYMBOL_REFRESH);
+    lv_obj_set_style_text_color(icon, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_text_font(icon, &lv_font_montserrat_22, 0);
+    lv_obj_center(icon);
+
+    /* Paddle, balls and HUD take their state from a fresh world */
+    new_game();
+
+#ifdef CONFIG_BB_UI_STATS
+    lvgl_heap_stats(&heap);
+    printk("ui: board uses %u objects, %u bytes of LVGL heap (%u used, max %u)\n",
+           count_objs(board), (unsigned int)(heap.allocated_bytes - heap_before),
+           (unsigned int)heap.allocated_bytes, (unsigned int)heap.max_allocated_bytes);
+#endif
+
+#ifndef CONFIG_BB_DIRECT_INPUT
     /* Touch moves paddle (and launches ball on first touch) */
     lv_obj_add_event_cb(board, paddle_touch_cb, LV_EVENT_PRESSING, NULL);
+#endif
 }
 
-/* ─── Game Logic ───────────────────────────────────────────────────────────── */
-
-static void reset_ball(void)
+/*
+ * Start a game on the existing objects: reset the world, hide the
+ * overlay and resync everything. No LVGL object is created or deleted.
+ */
+static void new_game(void)
 {
-    /* Position ball centered on paddle */
-    lv_coord_t px = lv_obj_get_x(paddle);
-    lv_coord_t pw = lv_obj_get_width(paddle);
-    ball_x = px + pw / 2 - BALL_RADIUS;
-    ball_y = lv_obj_get_y(paddle) - BALL_RADIUS * 2 - 1;
-    lv_obj_set_pos(ball, (lv_coord_t)ball_x, (lv_coord_t)ball_y);
-    ball_launched = false;
-    /* zero velocity until launch */
-    ball_vx = ball_vy = 0;
+    world_init(&world, world.w, world.h);
+#ifdef CONFIG_BB_LEVELS
+    level_index = 0;
+    start_level();
+#endif
+    lv_obj_add_flag(over_box, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(over_btn, LV_OBJ_FLAG_HIDDEN);
+    sync_ui();
 }
 
-static void update_game(lv_timer_t *t)
+/* ─── Sync ────────────────────────────────────────────────────────────────── */
+
+#ifndef CONFIG_BB_PLAYFIELD_WIDGET
+/*
+ * Match every brick object to the world. The objects were created with
+ * the board for the largest level; here they are only moved, restyled
+ * and hidden.
+ */
+static void sync_all_bricks(void)
 {
-    ARG_UNUSED(t);
+    int n = world.rows * world.cols;
 
-    if (!ball_launched)
+    for (int i = 0; i < n_brick_objs; i++)
     {
-        /* Follow paddle until first launch */
-        lv_coord_t px = lv_obj_get_x(paddle);
-        lv_coord_t pw = lv_obj_get_width(paddle);
-        ball_x = px + pw / 2 - BALL_RADIUS;
-        ball_y = lv_obj_get_y(paddle) - BALL_RADIUS * 2 - 1;
-        lv_obj_set_pos(ball, (lv_coord_t)ball_x, (lv_coord_t)ball_y);
-        return;
-    }
+        if (i >= n)
+        {
+            lv_obj_add_flag(bricks[i], LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
 
-    /* move ball */
-    ball_x += ball_vx;
-    ball_y += ball_vy;
+        const bb_rect_t *r = &world.brick_rect[i];
+        lv_obj_set_size(bricks[i], r->w, r->h);
+        lv_obj_set_pos(bricks[i], r->x, r->y);
+        if (world_brick_alive(&world, i))
+        {
+            lv_obj_set_style_bg_color(bricks[i],
+                                      lv_color_hex(world_brick_rgb(&world, i, theme->brick_hex)), 0);
+            lv_obj_clear_flag(bricks[i], LV_OBJ_FLAG_HIDDEN);
+        }
+        else
+        {
+            lv_obj_add_flag(bricks[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+#endif
 
-    lv_coord_t bw = lv_obj_get_width(board);
-    lv_coord_t bh = lv_obj_get_height(board);
+#ifndef CONFIG_BB_PLAYFIELD_WIDGET
+/* Show pool objects [0, n), hiding those beyond n shown by the last call */
+static void show_pool(lv_obj_t **objs, int n, int *shown)
+{
+    for (int i = *shown; i < n; i++)
+    {
+        lv_obj_clear_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+    }
+    for (int i = n; i < *shown; i++)
+    {
+        lv_obj_add_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+    }
+    *shown = n;
+}
+#endif
 
-    /* wall collisions */
-    if (ball_x <= 0)
+/* Push what the world changed since the last sync to the LVGL objects */
+static void sync_ui(void)
+{
+#ifdef CONFIG_BB_PLAYFIELD_WIDGET
+    /* balls and power-ups are drawn between steps, so they move on every frame */
+    playfield_sync(&world, render_alpha);
+#else
+    if (world.changed & WORLD_CHANGED_BRICKS)
     {
-        ball_x = 0;
-        ball_vx = -ball_vx;
+        sync_all_bricks();
     }
-    if (ball_x + BALL_RADIUS * 2 >= bw)
+    for (int i = 0; i < world.n_hit; i++)
     {
-        ball_x = bw - BALL_RADIUS * 2;
-        ball_vx = -ball_vx;
+        int b = world.hit[i];
+        if (world_brick_alive(&world, b))
+        {
+            /* damaged: darker */
+            lv_obj_set_style_bg_color(bricks[b],
+                                      lv_color_hex(world_brick_rgb(&world, b, theme->brick_hex)), 0);
+        }
+        else
+        {
+            lv_obj_add_flag(bricks[b], LV_OBJ_FLAG_HIDDEN);
+        }
     }
-    if (ball_y <= 0)
+    if (world.changed & WORLD_CHANGED_PADDLE)
     {
-        ball_y = 0;
-        ball_vy = -ball_vy;
+        lv_obj_set_size(paddle, world.paddle.w, world.paddle.h);
+        lv_obj_set_pos(paddle, world.paddle.x, world.paddle.y);
     }
-
-    /* brick collisions */
-    for (int r = 0; r < BRICK_ROWS; r++)
+    /* balls and power-ups are drawn between steps, so they move on every frame */
+    show_pool(balls, world.n_balls, &shown_balls);
+    for (int b = 0; b < world.n_balls; b++)
     {
-        for (int c = 0; c < BRICK_COLS; c++)
+        lv_obj_set_pos(balls[b],
+                       FX_TO_INT(world_ball_lerp(world.ball_prev_x[b], world.ball_x[b], render_alpha)),
+                       FX_TO_INT(world_ball_lerp(world.ball_prev_y[b], world.ball_y[b], render_alpha)));
+    }
+    if (world.changed & WORLD_CHANGED_POWERUPS)
+    {
+        show_pool(powerups, world.n_powerups, &shown_powerups);
+        for (int i = 0; i < world.n_powerups; i++)
         {
-            lv_obj_t *b = bricks[r][c];
-            if (!lv_obj_has_flag(b, LV_OBJ_FLAG_HIDDEN))
-            {
-                lv_coord_t bx = lv_obj_get_x(b), by = lv_obj_get_y(b);
-                lv_coord_t bwid = lv_obj_get_width(b), bhgt = lv_obj_get_height(b);
-                if (ball_x + BALL_RADIUS * 2 > bx && ball_x < bx + bwid &&
-                    ball_y + BALL_RADIUS * 2 > by && ball_y < by + bhgt)
-                {
-                    lv_obj_add_flag(b, LV_OBJ_FLAG_HIDDEN);
-                    ball_vy = -ball_vy;
-                    score += 10;
-                    lv_label_set_text_fmt(score_label, "Score: %d", score);
-                    goto after_brick;
-                }
-            }
+            lv_obj_set_style_bg_color(powerups[i], lv_color_hex(theme->powerup_hex[world.pu_kind[i]]),
+                                      0);
         }
     }
-after_brick:
+    for (int i = 0; i < world.n_powerups; i++)
+    {
+        lv_obj_set_pos(powerups[i], FX_TO_INT(world.pu_x[i]),
+                       FX_TO_INT(world_ball_lerp(world.pu_prev_y[i], world.pu_y[i], render_alpha)));
+    }
+#endif
+    if (world.changed & WORLD_CHANGED_SCORE)
+    {
+        lv_label_set_text_fmt(score_label, "Score: %d", world.score);
+    }
+    if (world.changed & WORLD_CHANGED_LIVES)
+    {
+        lv_label_set_text_fmt(lives_label, "Lives: %d", world.lives);
+    }
+    world_clear_changes(&world);
+}
 
-    /* paddle collision */
-    lv_coord_t px = lv_obj_get_x(paddle), py = lv_obj_get_y(paddle);
-    lv_coord_t pw = lv_obj_get_width(paddle);
-    if (ball_y + BALL_RADIUS * 2 >= py &&
-        ball_x + BALL_RADIUS * 2 > px && ball_x < px + pw)
+/* ─── Game Logic ───────────────────────────────────────────────────────────── */
+
+#ifdef CONFIG_BB_LEVELS
+/* Load level level_index of the pack (wrapping around) into the world */
+static void start_level(void)
+{
+    if (!levels_ok)
     {
-        ball_y = py - BALL_RADIUS * 2 - 1;
-        ball_vy = -ball_vy;
+        return;
     }
 
-    /* bottom: lose life */
-    if (ball_y + BALL_RADIUS * 2 >= bh)
+    bb_level_t lvl;
+#ifdef CONFIG_BB_UI_STATS
+    uint32_t t0 = k_cycle_get_32();
+#endif
+    level_pack_get(&levels, level_index % levels.n_levels, &lvl);
+    world_load_level(&world, &lvl);
+#ifdef CONFIG_BB_UI_STATS
+    printk("ui: level %d (%dx%d) loaded in %u us\n", level_index + 1, lvl.rows, lvl.cols,
+           k_cyc_to_us_floor32(k_cycle_get_32() - t0));
+#endif
+}
+#endif
+
+static void show_game_over(void)
+{
+    /* Stop the game loop and show the overlay made with the board */
+    lv_timer_pause(game_timer);
+    lv_obj_clear_flag(over_box, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(over_btn, LV_OBJ_FLAG_HIDDEN);
+}
+
+#ifdef CONFIG_BB_STEP_STATS
+static void report_steps(void)
+{
+    stat_frames++;
+    if (k_uptime_get() - stat_since < 5000)
     {
-        lives--;
-        lv_label_set_text_fmt(lives_label, "Lives: %d", lives);
-        /* If we detect "lives <= 0", show overlay and stop */
-        if (lives <= 0)
-        {
-            /* 1) Stop game loop */
-            lv_timer_del(game_timer);
-            game_timer = NULL;
-
-            lv_obj_t *scr = lv_scr_act();
-
-            /* 2) Game Over container with white border */
-            const lv_coord_t W = 200, H = 60;
-            lv_obj_t *cont = lv_obj_create(scr);
-            lv_obj_set_size(cont, W, H);
-            lv_obj_center(cont);
-            lv_obj_set_style_bg_color(cont, lv_color_hex(theme->board_bg_hex), 0);
-            lv_obj_set_style_border_width(cont, 2, 0);
-            lv_obj_set_style_border_color(cont, lv_color_hex(0xFFFFFF), 0);
-            lv_obj_set_style_radius(cont, 8, 0);
-            lv_obj_clear_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
-
-            /* 3) "Game Over" label */
-            lv_obj_t *lbl = lv_label_create(cont);
-            lv_label_set_text(lbl, "Game Over");
-            lv_obj_set_style_text_color(lbl, lv_color_hex(0xFFFFFF), 0);
-            lv_obj_set_style_text_font(lbl, &lv_font_montserrat_22, 0);
-            lv_obj_center(lbl);
-
-            /* 4) Restart button below */
-            lv_obj_t *btn = lv_btn_create(scr);
-            lv_obj_set_size(btn, 40, 40);
-            lv_obj_align(btn, LV_ALIGN_CENTER, 0, H / 2 + 20);
-            lv_obj_add_event_cb(btn, restart_game_cb, LV_EVENT_CLICKED, NULL);
-
-            /* make it transparent except for icon */
-            lv_obj_set_style_bg_opa(btn, LV_OPA_TRANSP, 0);
-            lv_obj_set_style_border_opa(btn, LV_OPA_TRANSP, 0);
-            lv_obj_set_style_shadow_opa(btn, LV_OPA_TRANSP, 0);
-
-            lv_obj_t *icon = lv_label_create(btn);
-            lv_label_set_text(icon, LV_SYMBOL_REFRESH);
-            lv_obj_set_style_text_color(icon, lv_color_hex(0xFFFFFF), 0);
-            lv_obj_set_style_text_font(icon, &lv_font_montserrat_22, 0);
-            lv_obj_center(icon);
-
-            return;
-        }
-        reset_ball();
+        return;
+    }
+    printk("steps: %u in %u frames, %u catch-up, %u dropped\n",
+           stat_steps, stat_frames, stat_catchup, stat_dropped);
+    stat_steps = stat_catchup = stat_dropped = stat_frames = 0;
+    stat_since = k_uptime_get();
+}
+#endif
+
+#ifdef CONFIG_BB_STRESS_SCENE
+/*
+ * Keep every ball and power-up slot in use, so the frame time can be
+ * measured at pool capacity (see CONFIG_BB_UI_STATS). Balls leave the
+ * paddle on four headings; power-ups fall from a row under the bricks.
+ */
+static void fill_pools(void)
+{
+    world_launch(&world);
+    for (int b = world.n_balls; b < WORLD_MAX_BALLS; b++)
+    {
+        fx_t vx = (b & 2) ? -INITIAL_BALL_VY : INITIAL_BALL_VX;
+        fx_t vy = (b & 2) ? -INITIAL_BALL_VX : INITIAL_BALL_VY;
+        world_add_ball(&world, FX_FROM_INT(world.paddle.x + world.paddle.w / 2 - BALL_RADIUS),
+                       FX_FROM_INT(world.paddle.y - BALL_RADIUS * 2 - 1), (b & 1) ? -vx : vx,
+                       vy);
+    }
+    for (int i = world.n_powerups; i < WORLD_MAX_POWERUPS; i++)
+    {
+        world_add_powerup(&world, (2 * i + 1) * world.w / (2 * WORLD_MAX_POWERUPS) - POWERUP_W / 2,
+                          world.h / 3, (bb_powerup_kind_t)(i % POWERUP_KINDS));
     }
+}
+#endif
 
-    lv_obj_set_pos(ball, (lv_coord_t)ball_x, (lv_coord_t)ball_y);
+/* Start or resume the frame timer with an empty step accumulator */
+static void start_game_timer(void)
+{
+    last_tick = k_uptime_ticks();
+    step_acc = 0;
+    render_alpha = 0;
+    if (game_timer)
+    {
+        lv_timer_resume(game_timer);
+    }
+    else
+    {
+        game_timer = lv_timer_create(update_game, CONFIG_BB_FRAME_MS, NULL);
+    }
+}
+
+/*
+ * Once per frame: run as many fixed steps as real time since the last
+ * frame requires (at most CONFIG_BB_MAX_CATCHUP_STEPS), then draw.
+ */
+static void update_game(lv_timer_t *t)
+{
+    ARG_UNUSED(t);
+
+    int64_t now = k_uptime_ticks();
+    int steps = 0;
+#ifdef CONFIG_BB_UI_STATS
+    uint32_t t0 = k_cycle_get_32();
+#endif
+#ifdef CONFIG_BB_STRESS_SCENE
+    fill_pools();
+#endif
+#ifdef CONFIG_BB_DIRECT_INPUT
+    /* the newest touch sample, or its extrapolation, for the steps below */
+    apply_touch();
+#endif
+
+    step_acc += (uint64_t)(now - last_tick) * WORLD_STEP_HZ;
+    last_tick = now;
+    while (step_acc >= TICKS_PER_SEC && steps < CONFIG_BB_MAX_CATCHUP_STEPS)
+    {
+        world_step(&world);
+        step_acc -= TICKS_PER_SEC;
+        steps++;
+    }
+    if (step_acc >= TICKS_PER_SEC)
+    {
+        /* too far behind: drop the backlog, the game slows down once */
+#ifdef CONFIG_BB_STEP_STATS
+        stat_dropped += step_acc / TICKS_PER_SEC;
+#endif
+        step_acc %= TICKS_PER_SEC;
+    }
+    render_alpha = (fx_t)(step_acc * FX_ONE / TICKS_PER_SEC);
+#ifdef CONFIG_BB_STEP_STATS
+    stat_steps += steps;
+    stat_catchup += steps > 1 ? steps - 1 : 0;
+    report_steps();
+#endif
+
+#ifdef CONFIG_BB_LEVELS
+    /* Level cleared: the next one starts with the ball on the paddle */
+    if (world.bricks_left == 0)
+    {
+        level_index++;
+        start_level();
+    }
+#endif
+
+    sync_ui();
+#ifdef CONFIG_BB_UI_STATS
+    uint32_t cyc = k_cycle_get_32() - t0;
+    ui_frames++;
+    ui_frame_cyc += cyc;
+    ui_frame_max = MAX(ui_frame_max, cyc);
+    ui_balls_max = MAX(ui_balls_max, world.n_balls);
+#endif
+
+    /* If we detect "lives <= 0", show overlay and stop */
+    if (world_game_over(&world))
+    {
+        show_game_over();
+    }
 }
 
 /* ─── Touch / Launch ───────────────────────────────────────────────────────── */
 
+#ifdef CONFIG_BB_DIRECT_INPUT
+/*
+ * Move the paddle to the latest touch sample, extrapolated by
+ * CONFIG_BB_INPUT_PREDICT_MS while the finger is down. Returns true if
+ * the paddle moved.
+ */
+static bool apply_touch(void)
+{
+    paddle_sample_t s;
+
+    paddle_input_read(&s);
+    bool fresh = s.seq != input_seq;
+    input_seq = s.seq;
+
+    /* under the overlay, the paddle waits for the restart */
+    if (!s.pressed || world_game_over(&world) || (!fresh && CONFIG_BB_INPUT_PREDICT_MS == 0))
+    {
+        return false;
+    }
+
+    /* on first touch, launch ball */
+    world_launch(&world);
+
+    int x = paddle_input_predict(&s, k_cycle_get_32(), CONFIG_BB_INPUT_PREDICT_MS);
+    int old_x = world.paddle.x;
+    world_set_paddle(&world, x - lv_obj_get_x(board));
+#ifdef CONFIG_BB_INPUT_STATS
+    if (fresh && world.paddle.x != old_x)
+    {
+        mark_touch(s.t_cyc);
+    }
+#endif
+    return world.paddle.x != old_x;
+}
+#else
 static void paddle_touch_cb(lv_event_t *e)
 {
     lv_point_t p;
@@ -299,48 +713,84 @@ static void paddle_touch_cb(lv_event_t *e)
     /* compute local x */
     lv_coord_t bx = lv_obj_get_x(board);
     lv_coord_t lx = p.x - bx;
-    lv_coord_t pw = lv_obj_get_width(paddle);
 
-    /* on first touch, launch ball */
-    if (!ball_launched)
+    /* under the overlay, the paddle waits for the restart */
+    if (world_game_over(&world))
     {
-        ball_launched = true;
-        ball_vx = INITIAL_BALL_VX;
-        ball_vy = INITIAL_BALL_VY;
+        return;
     }
 
-    /* move paddle */
-    lv_coord_t new_x = lx - pw / 2;
-    if (new_x < 0)
-        new_x = 0;
-    if (new_x + pw > lv_obj_get_width(board))
-        new_x = lv_obj_get_width(board) - pw;
-    lv_obj_set_x(paddle, new_x);
+    /* on first touch, launch ball */
+    world_launch(&world);
+
+    /* move paddle and draw it right away */
+#ifdef CONFIG_BB_INPUT_STATS
+    /* LVGL read the latest sample published, or an older one */
+    static uint32_t marked_seq;
+    paddle_sample_t s;
+    paddle_input_read(&s);
+    int old_x = world.paddle.x;
+    world_set_paddle(&world, lx);
+    if (s.seq != marked_seq && world.paddle.x != old_x)
+    {
+        marked_seq = s.seq;
+        mark_touch(s.t_cyc);
+    }
+#else
+    world_set_paddle(&world, lx);
+#endif
+    sync_ui();
 }
+#endif /* CONFIG_BB_DIRECT_INPUT */
 
 static void restart_game_cb(lv_event_t *e)
 {
     ARG_UNUSED(e);
 
-    /* 1) Stop any existing timer */
-    if (game_timer)
-    {
-        lv_timer_del(game_timer);
-        game_timer = NULL;
-    }
+    /* Same objects and timer, fresh world */
+    new_game();
+    start_game_timer();
+}
 
-    /* 2) Reset game state */
-    score = 0;
-    lives = 3;
-    ball_launched = false;
+#ifdef CONFIG_BB_RESTART_SOAK
+/*
+ * Lose and restart CONFIG_BB_RESTART_SOAK_CYCLES games, rendering each
+ * screen, and print the restart time and the LVGL heap in use and its
+ * high-water mark after the first and the last restart. Both should
+ * stay flat.
+ */
+static void restart_soak(void)
+{
+    struct sys_memory_stats first, heap;
+    uint32_t cyc = 0, cyc_max = 0;
 
-    /* 3) Clear entire screen and rebuild everything */
-    lv_obj_clean(lv_scr_act());
-    create_ui(lv_scr_act());
+    for (int i = 0; i < CONFIG_BB_RESTART_SOAK_CYCLES; i++)
+    {
+        world.lives = 0;
+        update_game(game_timer);
+        lv_timer_handler();
 
-    /* 4) Start a single new timer */
-    game_timer = lv_timer_create(update_game, 20, NULL);
+        uint32_t t0 = k_cycle_get_32();
+        restart_game_cb(NULL);
+        uint32_t c = k_cycle_get_32() - t0;
+        cyc += c;
+        cyc_max = MAX(cyc_max, c);
+        lv_timer_handler();
+
+        if (i == 0)
+        {
+            lvgl_heap_stats(&first);
+        }
+    }
+    lvgl_heap_stats(&heap);
+    printk("soak: %d restarts, %u us mean, %u us max; LVGL heap used %u -> %u bytes, "
+           "high-water %u -> %u bytes\n",
+           CONFIG_BB_RESTART_SOAK_CYCLES, k_cyc_to_us_floor32(cyc / CONFIG_BB_RESTART_SOAK_CYCLES),
+           k_cyc_to_us_floor32(cyc_max), (unsigned int)first.allocated_bytes,
+           (unsigned int)heap.allocated_bytes, (unsigned int)first.max_allocated_bytes,
+           (unsigned int)heap.max_allocated_bytes);
 }
+#endif
 
 /* ─── Main ───────────────────────────────────────────────────────────────── */
 
@@ -356,15 +806,53 @@ int main(void)
 
     lv_timer_handler();
 
+#ifdef CONFIG_BB_BENCH
+    bench_run();
+#endif
+#ifdef CONFIG_BB_STRESS
+    stress_run();
+#endif
+
+#ifdef CONFIG_BB_LEVELS
+    levels_ok = level_pack_open(level_pack_data, level_pack_size, &levels) == 0;
+    if (!levels_ok)
+    {
+        printk("Level pack invalid, playing the default bricks\n");
+    }
+#endif
+
+#ifdef CONFIG_BB_UI_STATS
+    lv_display_t *display = lv_display_get_default();
+    lv_display_add_event_cb(display, invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(display, refr_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(display, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+#endif
+#ifdef CONFIG_BB_INPUT_STATS
+    lv_display_add_event_cb(lv_display_get_default(), input_refr_ready_cb, LV_EVENT_REFR_READY,
+                            NULL);
+#endif
+
     lv_obj_t *scr = lv_scr_act();
     create_ui(scr);
 
-    game_timer = lv_timer_create(update_game, 20, NULL);
+    start_game_timer();
+#ifdef CONFIG_BB_RESTART_SOAK
+    restart_soak();
+#endif
 
     while (1)
     {
         lv_timer_handler();
+#ifdef CONFIG_BB_DIRECT_INPUT
+        /* a touch sample ends the wait and moves the paddle before the next frame */
+        paddle_input_wait(K_MSEC(10));
+        if (apply_touch())
+        {
+            sync_ui();
+        }
+#else
         k_sleep(K_MSEC(10));
+#endif
     }
     return 0;
 }
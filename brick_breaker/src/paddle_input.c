@@ -0,0 +1,143 @@
+/*
+ * Brick Breaker touch samples from the Zephyr input subsystem
+ */
+
+#include "paddle_input.h"
+
+#if defined(CONFIG_BB_DIRECT_INPUT) || defined(CONFIG_BB_INPUT_STATS)
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/input/input.h>
+#include <zephyr/sys/atomic.h>
+
+/*
+ * Listen to the touch controller behind LVGL's pointer and map its
+ * coordinates the way LVGL's pointer driver does, so both agree on where
+ * the finger is.
+ */
+#if DT_HAS_COMPAT_STATUS_OKAY(zephyr_lvgl_pointer_input)
+#define POINTER_NODE DT_COMPAT_GET_ANY_STATUS_OKAY(zephyr_lvgl_pointer_input)
+#define TOUCH_DEV DEVICE_DT_GET(DT_PHANDLE(POINTER_NODE, input))
+#define SWAP_XY DT_PROP(POINTER_NODE, swap_xy)
+#define INVERT_X DT_PROP(POINTER_NODE, invert_x)
+#define INVERT_Y DT_PROP(POINTER_NODE, invert_y)
+#else
+#define TOUCH_DEV NULL
+#define SWAP_XY 0
+#define INVERT_X 0
+#define INVERT_Y 0
+#endif
+#define SCREEN_W DT_PROP(DT_CHOSEN(zephyr_display), width)
+#define SCREEN_H DT_PROP(DT_CHOSEN(zephyr_display), height)
+
+/* ─── Slot ────────────────────────────────────────────────────────────────── */
+
+/*
+ * Latest-value triple buffer. The writer fills back, then swaps it with
+ * the middle buffer; the reader swaps a fresh middle buffer with front
+ * and copies front. Each side only touches the buffer it owns, and the
+ * one atomic swap is the whole handoff, so neither side ever waits on
+ * the other or masks interrupts.
+ */
+#define SLOT_FRESH 4 /* set in mid_slot by the writer, cleared by the reader */
+
+static paddle_sample_t slots[3];
+static atomic_t mid_slot = ATOMIC_INIT(1);
+static int back_slot;      /* input thread only */
+static int front_slot = 2; /* reader only */
+static K_SEM_DEFINE(sample_sem, 0, 1);
+
+static void publish(const paddle_sample_t *s)
+{
+    slots[back_slot] = *s;
+    back_slot = atomic_set(&mid_slot, back_slot | SLOT_FRESH) & ~SLOT_FRESH;
+    k_sem_give(&sample_sem);
+}
+
+void paddle_input_read(paddle_sample_t *s)
+{
+    if (atomic_get(&mid_slot) & SLOT_FRESH)
+    {
+        front_slot = atomic_set(&mid_slot, front_slot) & ~SLOT_FRESH;
+    }
+    *s = slots[front_slot];
+}
+
+void paddle_input_wait(k_timeout_t timeout)
+{
+    k_sem_take(&sample_sem, timeout);
+}
+
+/* ─── Input Callback ──────────────────────────────────────────────────────── */
+
+/* Report being assembled, and the last published sample, input thread only */
+static int16_t raw_x, raw_y;
+static bool raw_pressed;
+static paddle_sample_t last;
+
+static void touch_cb(struct input_event *evt, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    if (evt->type == INPUT_EV_ABS && evt->code == INPUT_ABS_X)
+    {
+        raw_x = evt->value;
+    }
+    else if (evt->type == INPUT_EV_ABS && evt->code == INPUT_ABS_Y)
+    {
+        raw_y = evt->value;
+    }
+    else if (evt->type == INPUT_EV_KEY && evt->code == INPUT_BTN_TOUCH)
+    {
+        raw_pressed = evt->value;
+    }
+    if (!evt->sync)
+    {
+        return;
+    }
+
+    paddle_sample_t s = {
+        .seq = last.seq + 1,
+        .t_cyc = k_cycle_get_32(),
+        .x = SWAP_XY ? raw_y : raw_x,
+        .y = SWAP_XY ? raw_x : raw_y,
+        .pressed = raw_pressed,
+    };
+    if (INVERT_X)
+    {
+        s.x = SCREEN_W - 1 - s.x;
+    }
+    if (INVERT_Y)
+    {
+        s.y = SCREEN_H - 1 - s.y;
+    }
+
+    /* velocity over the drag, averaged with the previous estimate */
+    uint32_t dt = s.t_cyc - last.t_cyc;
+    if (s.pressed && last.pressed && dt)
+    {
+        int32_t v = (int32_t)((int64_t)(s.x - last.x) * sys_clock_hw_cycles_per_sec() / dt);
+        s.vx = (last.vx + v) / 2;
+    }
+
+    publish(&s);
+    last = s;
+}
+INPUT_CALLBACK_DEFINE(TOUCH_DEV, touch_cb, NULL);
+
+/* ─── Prediction ──────────────────────────────────────────────────────────── */
+
+int paddle_input_predict(const paddle_sample_t *s, uint32_t now_cyc, int lead_ms)
+{
+    if (!s->pressed || lead_ms <= 0)
+    {
+        return s->x;
+    }
+
+    uint32_t ms = k_cyc_to_ms_floor32(now_cyc - s->t_cyc) + lead_ms;
+    ms = MIN(ms, PADDLE_INPUT_MAX_LEAD_MS);
+    return s->x + (int32_t)((int64_t)s->vx * ms / 1000);
+}
+
+#endif /* CONFIG_BB_DIRECT_INPUT || CONFIG_BB_INPUT_STATS */
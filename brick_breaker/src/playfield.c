@@ -0,0 +1,265 @@
+/*
+ * Brick Breaker playfield drawn by a single LVGL widget
+ */
+
+#include "playfield.h"
+
+#ifdef CONFIG_BB_PLAYFIELD_WIDGET
+
+#include <string.h>
+
+/*
+ * The draw event only needs to touch the bricks under the layer's clip
+ * area, but LVGL 9.2 has no public getter for it: lv_layer_t is declared
+ * in lvgl_private.h. The field is read only on 9.2, the version this
+ * was written against; any other version draws every live brick and
+ * leaves the clipping to LVGL.
+ */
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR == 2
+#include <lvgl_private.h>
+#define LAYER_CLIP(layer, obj_area) (&(layer)->_clip_area)
+#else
+#define LAYER_CLIP(layer, obj_area) (obj_area)
+#endif
+
+/* ─── State ───────────────────────────────────────────────────────────────── */
+
+/* One playfield per screen: the one create_ui() made last */
+static struct
+{
+    lv_obj_t *obj;
+    const bb_world_t *world;
+    /* drawn paddle, balls and power-ups, px relative to the playfield */
+    lv_area_t paddle;
+    lv_area_t ball[WORLD_MAX_BALLS];
+    int n_balls;
+    lv_area_t pu[WORLD_MAX_POWERUPS];
+    uint8_t pu_kind[WORLD_MAX_POWERUPS];
+    int n_pu;
+    uint32_t brick_hex; /* default bricks */
+    lv_color_t pu_color[POWERUP_KINDS];
+    lv_draw_rect_dsc_t brick_dsc, paddle_dsc, ball_dsc, pu_dsc;
+} pf;
+
+/* ─── Areas ───────────────────────────────────────────────────────────────── */
+
+static void set_area(lv_area_t *a, int x, int y, int w, int h)
+{
+    a->x1 = x;
+    a->y1 = y;
+    a->x2 = x + w - 1;
+    a->y2 = y + h - 1;
+}
+
+/* Screen area of a, which is relative to the playfield */
+static lv_area_t to_screen(const lv_area_t *a)
+{
+    lv_area_t o, abs = *a;
+
+    lv_obj_get_coords(pf.obj, &o);
+    abs.x1 += o.x1;
+    abs.x2 += o.x1;
+    abs.y1 += o.y1;
+    abs.y2 += o.y1;
+    return abs;
+}
+
+static void invalidate_local(const lv_area_t *a)
+{
+    lv_area_t abs = to_screen(a);
+
+    lv_obj_invalidate_area(pf.obj, &abs);
+}
+
+/* Move or resize a drawn area: invalidate where it was and where it goes */
+static void move_area(lv_area_t *a, int x, int y, int w, int h)
+{
+    if (a->x1 == x && a->y1 == y && lv_area_get_width(a) == w && lv_area_get_height(a) == h)
+    {
+        return;
+    }
+    invalidate_local(a);
+    set_area(a, x, y, w, h);
+    invalidate_local(a);
+}
+
+/* Start drawing a new area */
+static void show_area(lv_area_t *a, int x, int y, int w, int h)
+{
+    set_area(a, x, y, w, h);
+    invalidate_local(a);
+}
+
+/* ─── Drawing ─────────────────────────────────────────────────────────────── */
+
+/*
+ * First and last brick row or column whose cells overlap [lo, hi] (px
+ * relative to the playfield). False if none.
+ */
+static bool cell_range(int lo, int hi, int size, int n, int *first, int *last)
+{
+    int pitch = size + BRICK_MARGIN;
+
+    if (hi < BRICK_MARGIN)
+    {
+        return false;
+    }
+    *first = lo < BRICK_MARGIN ? 0 : (lo - BRICK_MARGIN) / pitch;
+    *last = (hi - BRICK_MARGIN) / pitch;
+    if (*last >= n)
+    {
+        *last = n - 1;
+    }
+    return *first <= *last;
+}
+
+static void draw_local(lv_layer_t *layer, const lv_draw_rect_dsc_t *dsc, const lv_area_t *a)
+{
+    lv_area_t abs = to_screen(a);
+
+    lv_draw_rect(layer, dsc, &abs);
+}
+
+/* Draw only the live bricks under the clip area, then the rest on top */
+static void draw_cb(lv_event_t *e)
+{
+    lv_layer_t *layer = lv_event_get_layer(e);
+    const bb_world_t *w = pf.world;
+    lv_area_t o;
+    int r0, r1, c0, c1;
+
+    lv_obj_get_coords(pf.obj, &o);
+    const lv_area_t *clip = LAYER_CLIP(layer, &o);
+    if (cell_range(clip->y1 - o.y1, clip->y2 - o.y1, w->brick_h, w->rows, &r0, &r1) &&
+        cell_range(clip->x1 - o.x1, clip->x2 - o.x1, w->brick_w, w->cols, &c0, &c1))
+    {
+        for (int r = r0; r <= r1; r++)
+        {
+            for (int c = c0; c <= c1; c++)
+            {
+                int i = r * w->cols + c;
+                if (world_brick_alive(w, i))
+                {
+                    const bb_rect_t *b = &w->brick_rect[i];
+                    lv_area_t a;
+                    set_area(&a, b->x, b->y, b->w, b->h);
+                    pf.brick_dsc.bg_color = lv_color_hex(world_brick_rgb(w, i, pf.brick_hex));
+                    draw_local(layer, &pf.brick_dsc, &a);
+                }
+            }
+        }
+    }
+    for (int i = 0; i < pf.n_pu; i++)
+    {
+        pf.pu_dsc.bg_color = pf.pu_color[pf.pu_kind[i]];
+        draw_local(layer, &pf.pu_dsc, &pf.pu[i]);
+    }
+    draw_local(layer, &pf.paddle_dsc, &pf.paddle);
+    for (int b = 0; b < pf.n_balls; b++)
+    {
+        draw_local(layer, &pf.ball_dsc, &pf.ball[b]);
+    }
+}
+
+/* ─── API ─────────────────────────────────────────────────────────────────── */
+
+lv_obj_t *playfield_create(lv_obj_t *parent, const bb_world_t *w,
+                           const playfield_colors_t *colors)
+{
+    pf.obj = lv_obj_create(parent);
+    pf.world = w;
+
+    /* no styles, no input: the parent keeps getting the touch events */
+    lv_obj_remove_style_all(pf.obj);
+    lv_obj_clear_flag(pf.obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(pf.obj, w->w, w->h);
+    lv_obj_set_pos(pf.obj, 0, 0);
+    lv_obj_add_event_cb(pf.obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_draw_rect_dsc_init(&pf.brick_dsc);
+    pf.brick_hex = colors->brick_hex;
+    lv_draw_rect_dsc_init(&pf.paddle_dsc);
+    pf.paddle_dsc.bg_color = colors->paddle;
+    pf.paddle_dsc.radius = PADDLE_HEIGHT / 2;
+    lv_draw_rect_dsc_init(&pf.ball_dsc);
+    pf.ball_dsc.bg_color = colors->ball;
+    pf.ball_dsc.radius = BALL_RADIUS;
+    lv_draw_rect_dsc_init(&pf.pu_dsc);
+    pf.pu_dsc.radius = POWERUP_H / 2;
+    memcpy(pf.pu_color, colors->powerup, sizeof(pf.pu_color));
+
+    /* the first sync draws the balls and power-ups */
+    set_area(&pf.paddle, w->paddle.x, w->paddle.y, w->paddle.w, w->paddle.h);
+    pf.n_balls = 0;
+    pf.n_pu = 0;
+    return pf.obj;
+}
+
+void playfield_sync(const bb_world_t *w, fx_t alpha)
+{
+    if (w->changed & WORLD_CHANGED_BRICKS)
+    {
+        /* new layout, or too many to list: redraw the whole brick area */
+        lv_area_t a;
+        set_area(&a, 0, 0, w->w, w->h / 3);
+        invalidate_local(&a);
+    }
+    for (int i = 0; i < w->n_hit; i++)
+    {
+        const bb_rect_t *b = &w->brick_rect[w->hit[i]];
+        lv_area_t a;
+        set_area(&a, b->x, b->y, b->w, b->h);
+        invalidate_local(&a);
+    }
+    if (w->changed & WORLD_CHANGED_PADDLE)
+    {
+        move_area(&pf.paddle, w->paddle.x, w->paddle.y, w->paddle.w, w->paddle.h);
+    }
+
+    /* balls: moved slots, then slots that came and went since the last sync */
+    for (int b = 0; b < w->n_balls; b++)
+    {
+        int x = FX_TO_INT(world_ball_lerp(w->ball_prev_x[b], w->ball_x[b], alpha));
+        int y = FX_TO_INT(world_ball_lerp(w->ball_prev_y[b], w->ball_y[b], alpha));
+        if (b < pf.n_balls)
+        {
+            move_area(&pf.ball[b], x, y, BALL_RADIUS * 2, BALL_RADIUS * 2);
+        }
+        else
+        {
+            show_area(&pf.ball[b], x, y, BALL_RADIUS * 2, BALL_RADIUS * 2);
+        }
+    }
+    for (int b = w->n_balls; b < pf.n_balls; b++)
+    {
+        invalidate_local(&pf.ball[b]);
+    }
+    pf.n_balls = w->n_balls;
+
+    /* power-ups: the same, redrawn where a slot changed kind */
+    for (int i = 0; i < w->n_powerups; i++)
+    {
+        int x = FX_TO_INT(w->pu_x[i]);
+        int y = FX_TO_INT(world_ball_lerp(w->pu_prev_y[i], w->pu_y[i], alpha));
+        if (i < pf.n_pu && pf.pu_kind[i] == w->pu_kind[i])
+        {
+            move_area(&pf.pu[i], x, y, POWERUP_W, POWERUP_H);
+        }
+        else
+        {
+            if (i < pf.n_pu)
+            {
+                invalidate_local(&pf.pu[i]);
+            }
+            show_area(&pf.pu[i], x, y, POWERUP_W, POWERUP_H);
+        }
+        pf.pu_kind[i] = w->pu_kind[i];
+    }
+    for (int i = w->n_powerups; i < pf.n_pu; i++)
+    {
+        invalidate_local(&pf.pu[i]);
+    }
+    pf.n_pu = w->n_powerups;
+}
+
+#endif /* CONFIG_BB_PLAYFIELD_WIDGET */
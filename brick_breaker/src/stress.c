@@ -0,0 +1,197 @@
+/*
+ * Boot-time collision stress test for Brick Breaker: fast balls vs tunneling
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "stress.h"
+#include "world.h"
+
+#ifdef CONFIG_BB_STRESS
+
+/* Same board as create_ui() on the 480x320 panel */
+#define BOARD_W 480
+#define BOARD_H 320
+/* Points tested along a straight step */
+#define PATH_SAMPLES 32
+/* Penetration tolerated, Q16.16 px (rounding of the contact point) */
+#define SLOP (FX_ONE / 16)
+
+static bb_world_t world;
+
+/* Does a ball centered at (cx, cy) sink more than SLOP into rect r? */
+static bool ball_in_rect(fx_t cx, fx_t cy, const bb_rect_t *r)
+{
+    fx_t x0 = FX_FROM_INT(r->x), x1 = FX_FROM_INT(r->x + r->w);
+    fx_t y0 = FX_FROM_INT(r->y), y1 = FX_FROM_INT(r->y + r->h);
+    int64_t dx = cx < x0 ? x0 - cx : cx > x1 ? cx - x1 : 0;
+    int64_t dy = cy < y0 ? y0 - cy : cy > y1 ? cy - y1 : 0;
+    int64_t lim = FX_FROM_INT(BALL_RADIUS) - SLOP;
+
+    return dx * dx + dy * dy < lim * lim;
+}
+
+static bool ball_in_anything(const bb_world_t *w, fx_t cx, fx_t cy)
+{
+    for (int i = 0; i < BRICK_COUNT; i++)
+    {
+        if (world_brick_alive(w, i) && ball_in_rect(cx, cy, &w->brick_rect[i]))
+        {
+            return true;
+        }
+    }
+    return ball_in_rect(cx, cy, &w->paddle);
+}
+
+struct stress_stats
+{
+    uint32_t bricks, lives_lost;
+    uint32_t tunnels;  /* straight steps that passed through something */
+    uint32_t inside;   /* steps ending inside a brick or the paddle */
+    uint32_t escapes;  /* steps ending outside the board */
+};
+
+static void stress_speed(int mult, struct stress_stats *st)
+{
+    const fx_t rad = FX_FROM_INT(BALL_RADIUS);
+
+    world_init(&world, BOARD_W, BOARD_H);
+    for (int i = 0; i < CONFIG_BB_STRESS_STEPS; i++)
+    {
+        if (world.bricks_left == 0 || world_game_over(&world))
+        {
+            world_init(&world, BOARD_W, BOARD_H);
+        }
+        /* one ball, same paddle: no power-ups */
+        world.powerup_pct = 0;
+        if (!world.ball_launched)
+        {
+            world_launch(&world);
+            world.ball_vx[0] = INITIAL_BALL_VX * mult;
+            world.ball_vy[0] = INITIAL_BALL_VY * mult;
+        }
+        /* follow the ball, off center by a slowly changing amount */
+        world_set_paddle(&world, FX_TO_INT(world.ball_x[0] + rad) + (i / 500 % 5 - 2) * 12);
+
+        fx_t vx = world.ball_vx[0], vy = world.ball_vy[0];
+        int bricks = world.bricks_left, lives = world.lives;
+        world_step(&world);
+        world_clear_changes(&world);
+        st->bricks += bricks - world.bricks_left;
+
+        if (world.lives != lives)
+        {
+            st->lives_lost++;
+            continue;
+        }
+        fx_t cx = world.ball_x[0] + rad, cy = world.ball_y[0] + rad;
+        if (world.ball_x[0] < 0 || world.ball_y[0] < 0 ||
+            world.ball_x[0] + BALL_SIZE > FX_FROM_INT(BOARD_W))
+        {
+            st->escapes++;
+        }
+        if (ball_in_anything(&world, cx, cy))
+        {
+            st->inside++;
+        }
+        /* no bounce and nothing broken: the whole path must be clear */
+        if (vx == world.ball_vx[0] && vy == world.ball_vy[0] && bricks == world.bricks_left)
+        {
+            fx_t px = world.ball_prev_x[0] + rad, py = world.ball_prev_y[0] + rad;
+            for (int k = 1; k < PATH_SAMPLES; k++)
+            {
+                if (ball_in_anything(&world, px + (cx - px) / PATH_SAMPLES * k,
+                                     py + (cy - py) / PATH_SAMPLES * k))
+                {
+                    st->tunnels++;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Step cost with n balls in play and every power-up slot falling: balls
+ * and power-ups that leave are put back, so each step runs at n.
+ * Returns cycles per step; *escapes counts balls that left the board.
+ */
+static uint32_t stress_pools(int n, uint32_t *escapes)
+{
+    uint32_t cyc = 0;
+
+    world_init(&world, BOARD_W, BOARD_H);
+    world_launch(&world);
+    for (int i = 0; i < CONFIG_BB_STRESS_STEPS; i++)
+    {
+        if (world.bricks_left == 0 || world_game_over(&world))
+        {
+            world_init(&world, BOARD_W, BOARD_H);
+            world_launch(&world);
+        }
+        while (world.n_balls < n)
+        {
+            int b = world.n_balls;
+            world_add_ball(&world, FX_FROM_INT(BOARD_W / 2 + 16 * b - 64), FX_FROM_INT(BOARD_H / 2),
+                           (b & 1) ? -INITIAL_BALL_VX : INITIAL_BALL_VX, INITIAL_BALL_VY);
+        }
+        while (world.n_powerups < WORLD_MAX_POWERUPS)
+        {
+            int k = world.n_powerups;
+            world_add_powerup(&world, (2 * k + 1) * BOARD_W / (2 * WORLD_MAX_POWERUPS), BOARD_H / 3,
+                              POWERUP_LIFE);
+        }
+        world_set_paddle(&world, FX_TO_INT(world.ball_x[0]) + BALL_RADIUS);
+
+        uint32_t t0 = k_cycle_get_32();
+        world_step(&world);
+        cyc += k_cycle_get_32() - t0;
+        world_clear_changes(&world);
+
+        for (int b = 0; b < world.n_balls; b++)
+        {
+            if (world.ball_x[b] < 0 || world.ball_y[b] < 0 ||
+                world.ball_x[b] + BALL_SIZE > FX_FROM_INT(BOARD_W))
+            {
+                (*escapes)++;
+            }
+        }
+    }
+    return cyc / CONFIG_BB_STRESS_STEPS;
+}
+
+void stress_run(void)
+{
+    static const int mults[] = {1, 2, 4, 8, 16};
+
+    for (size_t k = 0; k < ARRAY_SIZE(mults); k++)
+    {
+        struct stress_stats st = {0};
+        uint32_t t0 = k_cycle_get_32();
+
+        stress_speed(mults[k], &st);
+        uint32_t cyc = k_cycle_get_32() - t0;
+
+        printk("stress: %2dx speed (%d,%d px/step), %u bricks, %u lives lost, "
+               "%u tunnels, %u inside, %u escapes, %u cyc/step\n",
+               mults[k], FX_TO_INT(INITIAL_BALL_VX * mults[k]),
+               FX_TO_INT(INITIAL_BALL_VY * mults[k]), st.bricks, st.lives_lost,
+               st.tunnels, st.inside, st.escapes, cyc / CONFIG_BB_STRESS_STEPS);
+    }
+
+    for (int n = 1;; n = MIN(n * 2, WORLD_MAX_BALLS))
+    {
+        uint32_t escapes = 0;
+        uint32_t cyc = stress_pools(n, &escapes);
+
+        printk("stress: %d balls, %d power-ups, %u cyc/step, %u cyc/ball, %u escapes\n", n,
+               WORLD_MAX_POWERUPS, cyc, cyc / n, escapes);
+        if (n == WORLD_MAX_BALLS)
+        {
+            break;
+        }
+    }
+}
+
+#endif /* CONFIG_BB_STRESS */
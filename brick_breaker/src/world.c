@@ -0,0 +1,742 @@
+/*
+ * Brick Breaker simulation step, free of LVGL
+ */
+
+#include <string.h>
+
+#include "world.h"
+
+/* ─── Layout ──────────────────────────────────────────────────────────────── */
+
+/* One ball left, resting on top of the paddle */
+static void reset_ball(bb_world_t *w)
+{
+    w->n_balls = 1;
+    w->ball_x[0] = FX_FROM_INT(w->paddle.x + w->paddle.w / 2 - BALL_RADIUS);
+    w->ball_y[0] = FX_FROM_INT(w->paddle.y - BALL_RADIUS * 2 - 1);
+    w->ball_vx[0] = w->ball_vy[0] = 0;
+    w->ball_launched = false;
+    /* no interpolation across the jump */
+    w->ball_prev_x[0] = w->ball_x[0];
+    w->ball_prev_y[0] = w->ball_y[0];
+    w->changed |= WORLD_CHANGED_BALL;
+}
+
+/* Resize the paddle around its center, kept on the board */
+static void set_paddle_width(bb_world_t *w, int width)
+{
+    int cx = w->paddle.x + w->paddle.w / 2;
+
+    w->paddle.w = width;
+    w->paddle.x = -1; /* force the update */
+    world_set_paddle(w, cx);
+}
+
+/* Grid of rows x cols bricks filling the top third of the board */
+static void layout_bricks(bb_world_t *w, int rows, int cols)
+{
+    int bricks_h = w->h / 3;
+
+    memset(w->brick_alive, 0, sizeof(w->brick_alive));
+    w->rows = rows;
+    w->cols = cols;
+    w->brick_h = (bricks_h - (rows + 1) * BRICK_MARGIN) / rows;
+    w->brick_w = (w->w - (cols + 1) * BRICK_MARGIN) / cols;
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            bb_rect_t *b = &w->brick_rect[r * cols + c];
+            b->x = BRICK_MARGIN + c * (w->brick_w + BRICK_MARGIN);
+            b->y = BRICK_MARGIN + r * (w->brick_h + BRICK_MARGIN);
+            b->w = w->brick_w;
+            b->h = w->brick_h;
+        }
+    }
+    w->changed |= WORLD_CHANGED_BRICKS;
+}
+
+void world_init(bb_world_t *w, int width, int height)
+{
+    memset(w, 0, sizeof(*w));
+    w->w = width;
+    w->h = height;
+
+    layout_bricks(w, BRICK_ROWS, BRICK_COLS);
+    for (int i = 0; i < BRICK_ROWS * BRICK_COLS; i++)
+    {
+        w->brick_alive[i / 32] |= 1U << (i % 32);
+        w->brick_hits[i] = 1;
+    }
+    w->bricks_left = BRICK_ROWS * BRICK_COLS;
+
+    w->paddle.w = w->paddle_base_w = width / PADDLE_WIDTH_SCALE;
+    w->paddle.h = PADDLE_HEIGHT;
+    w->paddle.x = (width - w->paddle.w) / 2;
+    w->paddle.y = height - PADDLE_HEIGHT - BRICK_MARGIN - HUD_MARGIN;
+
+    w->lives = INITIAL_LIVES;
+    w->powerup_pct = POWERUP_PCT;
+    w->rng = 1;
+    reset_ball(w);
+    w->changed = WORLD_CHANGED_BALL | WORLD_CHANGED_PADDLE | WORLD_CHANGED_BRICKS |
+                 WORLD_CHANGED_SCORE | WORLD_CHANGED_LIVES | WORLD_CHANGED_POWERUPS;
+}
+
+void world_load_level(bb_world_t *w, const bb_level_t *lvl)
+{
+    layout_bricks(w, lvl->rows, lvl->cols);
+    w->types = lvl->types;
+    w->bricks_left = 0;
+    for (int r = 0; r < lvl->rows; r++)
+    {
+        for (int c = 0; c < lvl->cols; c++)
+        {
+            int i = r * lvl->cols + c;
+            int t = level_cell(lvl, r, c);
+            if (t == 0)
+            {
+                continue;
+            }
+            w->brick_alive[i / 32] |= 1U << (i % 32);
+            w->brick_type[i] = t - 1;
+            w->brick_hits[i] = lvl->types[t - 1].hits;
+            w->bricks_left += w->brick_hits[i] != 0;
+        }
+    }
+    w->n_powerups = 0;
+    w->changed |= WORLD_CHANGED_POWERUPS;
+    reset_ball(w);
+}
+
+void world_set_paddle(bb_world_t *w, int cx)
+{
+    int x = cx - w->paddle.w / 2;
+
+    if (x < 0)
+    {
+        x = 0;
+    }
+    if (x + w->paddle.w > w->w)
+    {
+        x = w->w - w->paddle.w;
+    }
+    if (x != w->paddle.x)
+    {
+        w->paddle.x = x;
+        w->changed |= WORLD_CHANGED_PADDLE;
+    }
+}
+
+void world_launch(bb_world_t *w)
+{
+    if (!w->ball_launched)
+    {
+        w->ball_launched = true;
+        w->ball_vx[0] = INITIAL_BALL_VX;
+        w->ball_vy[0] = INITIAL_BALL_VY;
+    }
+}
+
+bool world_add_ball(bb_world_t *w, fx_t x, fx_t y, fx_t vx, fx_t vy)
+{
+    if (w->n_balls == WORLD_MAX_BALLS)
+    {
+        return false;
+    }
+
+    int b = w->n_balls++;
+    w->ball_x[b] = w->ball_prev_x[b] = x;
+    w->ball_y[b] = w->ball_prev_y[b] = y;
+    w->ball_vx[b] = vx;
+    w->ball_vy[b] = vy;
+    w->changed |= WORLD_CHANGED_BALL;
+    return true;
+}
+
+bool world_add_powerup(bb_world_t *w, int x, int y, bb_powerup_kind_t kind)
+{
+    if (w->n_powerups == WORLD_MAX_POWERUPS)
+    {
+        return false;
+    }
+
+    int i = w->n_powerups++;
+    w->pu_x[i] = FX_FROM_INT(x);
+    w->pu_y[i] = w->pu_prev_y[i] = FX_FROM_INT(y);
+    w->pu_kind[i] = kind;
+    w->changed |= WORLD_CHANGED_POWERUPS;
+    return true;
+}
+
+static uint32_t world_rand(bb_world_t *w)
+{
+    uint32_t x = w->rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return w->rng = x;
+}
+
+/* ─── Swept collision ─────────────────────────────────────────────────────── */
+
+/*
+ * The ball is a circle swept along its displacement. Each sweep finds the
+ * earliest contact (time of impact as a Q16.16 fraction of the sweep),
+ * moves the ball there, reflects the velocity on the contact normal and
+ * sweeps the rest, so nothing is skipped however fast the ball moves.
+ */
+
+/* Longest sweep, px; faster balls are moved in several substeps */
+#define MAX_SWEEP_PX 8
+/* Contacts resolved per substep; the rest of the substep is dropped */
+#define MAX_CONTACTS 8
+/* Contacts closer in time than this are resolved together */
+#define TOI_TIE (FX_ONE >> 10)
+/* Time of impact of a sweep that hits nothing */
+#define NO_HIT INT64_MAX
+
+typedef enum
+{
+    HIT_WALL,
+    HIT_BRICK,
+    HIT_PADDLE,
+} hit_kind_t;
+
+typedef struct
+{
+    int64_t t;      /* Q16.16 fraction of the sweep */
+    int8_t nx, ny;  /* sign of the surface normal per axis, 0 if none */
+    bool corner;    /* normal from a rounded corner, not a face */
+    hit_kind_t kind;
+    int16_t brick;
+} contact_t;
+
+/* Part of displacement d covered by time t, rounded toward zero */
+static fx_t advance(fx_t d, int64_t t)
+{
+    return (fx_t)(((int64_t)d * t) / FX_ONE);
+}
+
+/* Entry and exit times of p + t * d through the slab [lo, hi] */
+static bool slab(fx_t p, fx_t d, fx_t lo, fx_t hi, int64_t *t_in, int64_t *t_out)
+{
+    if (d == 0)
+    {
+        if (p <= lo || p >= hi)
+        {
+            return false;
+        }
+        *t_in = INT64_MIN;
+        *t_out = INT64_MAX;
+        return true;
+    }
+    int64_t a = ((int64_t)(lo - p) << FX_SHIFT) / d;
+    int64_t b = ((int64_t)(hi - p) << FX_SHIFT) / d;
+    *t_in = a < b ? a : b;
+    *t_out = a < b ? b : a;
+    return true;
+}
+
+static uint32_t isqrt64(uint64_t v)
+{
+    uint64_t r = 0, bit = 1ULL << 62;
+
+    while (bit > v)
+    {
+        bit >>= 2;
+    }
+    while (bit)
+    {
+        if (v >= r + bit)
+        {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else
+        {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+/*
+ * Sweep of the ball center (cx, cy) by (dx, dy) against the corner point
+ * (kx, ky) with radius BALL_RADIUS. Solved in Q24.8, which keeps the
+ * squares in 64 bits for sweeps of up to MAX_SWEEP_PX.
+ */
+static bool sweep_corner(fx_t cx, fx_t cy, fx_t dx, fx_t dy, fx_t kx, fx_t ky, contact_t *c)
+{
+    int64_t mx = (cx - kx) >> 8, my = (cy - ky) >> 8;
+    int64_t ex = dx >> 8, ey = dy >> 8;
+    int64_t r = BALL_RADIUS << 8;
+    int64_t a = ex * ex + ey * ey;
+    int64_t b = mx * ex + my * ey;
+    int64_t k = mx * mx + my * my - r * r;
+
+    if (a == 0 || b >= 0)
+    {
+        /* still or moving away from the corner */
+        return false;
+    }
+    int64_t disc = b * b - a * k;
+    if (disc < 0)
+    {
+        return false;
+    }
+    int64_t t = ((-b - (int64_t)isqrt64((uint64_t)disc)) << FX_SHIFT) / a;
+    if (t > FX_ONE)
+    {
+        return false;
+    }
+    t = t < 0 ? 0 : t;
+
+    /* normal at the contact point */
+    int64_t nx = mx + ex * t / FX_ONE, ny = my + ey * t / FX_ONE;
+    int64_t ax = nx < 0 ? -nx : nx, ay = ny < 0 ? -ny : ny;
+    c->t = t;
+    c->nx = ay > 2 * ax ? 0 : (nx > 0) - (nx < 0);
+    c->ny = ax > 2 * ay ? 0 : (ny > 0) - (ny < 0);
+    c->corner = true;
+    return true;
+}
+
+/*
+ * Sweep of the ball center against rect r grown by the ball radius. Face
+ * hits are found with the slab test; when the entry point is past the
+ * end of the face, the ball meets the rounded corner instead.
+ */
+static bool sweep_rect(fx_t cx, fx_t cy, fx_t dx, fx_t dy, const bb_rect_t *r, contact_t *c)
+{
+    const fx_t rad = FX_FROM_INT(BALL_RADIUS);
+    fx_t x0 = FX_FROM_INT(r->x), x1 = FX_FROM_INT(r->x + r->w);
+    fx_t y0 = FX_FROM_INT(r->y), y1 = FX_FROM_INT(r->y + r->h);
+    int64_t tx_in, tx_out, ty_in, ty_out;
+
+    if (!slab(cx, dx, x0 - rad, x1 + rad, &tx_in, &tx_out) ||
+        !slab(cy, dy, y0 - rad, y1 + rad, &ty_in, &ty_out))
+    {
+        return false;
+    }
+    int64_t t_in = tx_in > ty_in ? tx_in : ty_in;
+    int64_t t_out = tx_out < ty_out ? tx_out : ty_out;
+    if (t_in >= t_out || t_out <= 0 || t_in > FX_ONE)
+    {
+        return false;
+    }
+
+    /* the grown box has square corners: the ball may start inside one */
+    int64_t t = t_in < 0 ? 0 : t_in;
+    fx_t hx = cx + advance(dx, t), hy = cy + advance(dy, t);
+    bool in_x = hx >= x0 && hx <= x1, in_y = hy >= y0 && hy <= y1;
+    if (!in_x && !in_y)
+    {
+        return sweep_corner(cx, cy, dx, dy, hx < x0 ? x0 : x1, hy < y0 ? y0 : y1, c);
+    }
+    if (t_in < 0)
+    {
+        /* overlapping already: left alone, the ball moves out */
+        return false;
+    }
+    c->t = t_in;
+    c->nx = tx_in >= ty_in ? (dx < 0) - (dx > 0) : 0;
+    c->ny = ty_in >= tx_in ? (dy < 0) - (dy > 0) : 0;
+    c->corner = false;
+    return true;
+}
+
+/* Wall contact of coordinate p moving by d toward limit lim (ball center) */
+static void sweep_wall(fx_t p, fx_t d, fx_t lim, int8_t n, bool y, contact_t *c)
+{
+    int64_t t = ((int64_t)(lim - p) << FX_SHIFT) / d;
+
+    c->t = t < 0 ? 0 : t;
+    c->nx = y ? 0 : n;
+    c->ny = y ? n : 0;
+    c->corner = false;
+    c->kind = HIT_WALL;
+}
+
+/*
+ * Grid cells [*lo, *hi] along one axis whose pitch (brick plus the margin
+ * after it) overlaps the span [from, to]. False if none.
+ */
+static bool brick_span(fx_t from, fx_t to, int size, int n, int *lo, int *hi)
+{
+    fx_t pitch = FX_FROM_INT(size + BRICK_MARGIN);
+    fx_t rel = from - FX_FROM_INT(BRICK_MARGIN);
+
+    if (to - FX_FROM_INT(BRICK_MARGIN) < 0)
+    {
+        return false;
+    }
+    *lo = rel < 0 ? 0 : rel / pitch;
+    *hi = (to - FX_FROM_INT(BRICK_MARGIN)) / pitch;
+    if (*hi >= n)
+    {
+        *hi = n - 1;
+    }
+    return *lo <= *hi;
+}
+
+/* Keep the earliest contacts; ties (within TOI_TIE) are all kept */
+static void add_contact(contact_t *hits, int *n, const contact_t *c)
+{
+    if (*n > 0 && c->t > hits[0].t + TOI_TIE)
+    {
+        return;
+    }
+    if (*n > 0 && c->t + TOI_TIE < hits[0].t)
+    {
+        *n = 0;
+    }
+    if (*n < MAX_CONTACTS)
+    {
+        /* hits[0] stays the earliest */
+        if (*n > 0 && c->t < hits[0].t)
+        {
+            hits[*n] = hits[0];
+            hits[0] = *c;
+        }
+        else
+        {
+            hits[*n] = *c;
+        }
+        (*n)++;
+    }
+}
+
+/* Earliest contacts of the ball center sweeping by (dx, dy) */
+static int find_contacts(const bb_world_t *w, fx_t cx, fx_t cy, fx_t dx, fx_t dy,
+                         contact_t *hits)
+{
+    const fx_t rad = FX_FROM_INT(BALL_RADIUS);
+    contact_t c;
+    int n = 0;
+
+    if (dx < 0)
+    {
+        sweep_wall(cx, dx, rad, 1, false, &c);
+        if (c.t <= FX_ONE)
+        {
+            add_contact(hits, &n, &c);
+        }
+    }
+    if (dx > 0)
+    {
+        sweep_wall(cx, dx, FX_FROM_INT(w->w) - rad, -1, false, &c);
+        if (c.t <= FX_ONE)
+        {
+            add_contact(hits, &n, &c);
+        }
+    }
+    if (dy < 0)
+    {
+        sweep_wall(cy, dy, rad, 1, true, &c);
+        if (c.t <= FX_ONE)
+        {
+            add_contact(hits, &n, &c);
+        }
+    }
+
+    /* bricks: only the grid cells the swept ball passes over */
+    int r0, r1, c0, c1;
+    fx_t x_lo = (dx < 0 ? cx + dx : cx) - rad, x_hi = (dx < 0 ? cx : cx + dx) + rad;
+    fx_t y_lo = (dy < 0 ? cy + dy : cy) - rad, y_hi = (dy < 0 ? cy : cy + dy) + rad;
+    if (brick_span(y_lo, y_hi, w->brick_h, w->rows, &r0, &r1) &&
+        brick_span(x_lo, x_hi, w->brick_w, w->cols, &c0, &c1))
+    {
+        for (int r = r0; r <= r1; r++)
+        {
+            for (int col = c0; col <= c1; col++)
+            {
+                int i = r * w->cols + col;
+                if (world_brick_alive(w, i) &&
+                    sweep_rect(cx, cy, dx, dy, &w->brick_rect[i], &c))
+                {
+                    c.kind = HIT_BRICK;
+                    c.brick = i;
+                    add_contact(hits, &n, &c);
+                }
+            }
+        }
+    }
+
+    if (sweep_rect(cx, cy, dx, dy, &w->paddle, &c))
+    {
+        c.kind = HIT_PADDLE;
+        add_contact(hits, &n, &c);
+    }
+    return n;
+}
+
+/* Take one hit point off brick i; unbreakable bricks only bounce the ball */
+static void hit_brick(bb_world_t *w, int i)
+{
+    if (w->brick_hits[i] == 0)
+    {
+        return;
+    }
+    if (--w->brick_hits[i] == 0)
+    {
+        w->brick_alive[i / 32] &= ~(1U << (i % 32));
+        w->bricks_left--;
+        if (w->powerup_pct && world_rand(w) % 100 < w->powerup_pct)
+        {
+            const bb_rect_t *r = &w->brick_rect[i];
+            world_add_powerup(w, r->x + (r->w - POWERUP_W) / 2, r->y,
+                              (bb_powerup_kind_t)(world_rand(w) % POWERUP_KINDS));
+        }
+    }
+    if (w->n_hit < WORLD_MAX_HIT)
+    {
+        w->hit[w->n_hit++] = i;
+    }
+    else
+    {
+        w->changed |= WORLD_CHANGED_BRICKS;
+    }
+    w->score += BRICK_POINTS;
+    w->changed |= WORLD_CHANGED_SCORE;
+}
+
+/* Point v away from the surface on each axis the normal has */
+static void reflect(fx_t *v, int8_t n)
+{
+    if ((n > 0 && *v < 0) || (n < 0 && *v > 0))
+    {
+        *v = -*v;
+    }
+}
+
+/*
+ * Move the ball by (dx, dy), bouncing off everything in the way. All
+ * contacts at the same time are resolved together: every brick touched
+ * takes a hit, and each axis reflects once. A face contact decides the axes
+ * over a simultaneous corner contact, so a ball hitting the seam between
+ * two bricks bounces as off one flat face.
+ */
+static void sweep_ball(bb_world_t *w, int b, fx_t dx, fx_t dy)
+{
+    const fx_t rad = FX_FROM_INT(BALL_RADIUS);
+    fx_t cx = w->ball_x[b] + rad, cy = w->ball_y[b] + rad;
+    contact_t hits[MAX_CONTACTS];
+
+    for (int k = 0; k < MAX_CONTACTS && (dx || dy); k++)
+    {
+        int n = find_contacts(w, cx, cy, dx, dy, hits);
+        if (n == 0)
+        {
+            cx += dx;
+            cy += dy;
+            break;
+        }
+
+        fx_t ax = advance(dx, hits[0].t), ay = advance(dy, hits[0].t);
+        cx += ax;
+        cy += ay;
+        dx -= ax;
+        dy -= ay;
+
+        bool face = false;
+        for (int i = 0; i < n; i++)
+        {
+            face |= !hits[i].corner;
+        }
+        int8_t nx = 0, ny = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (hits[i].kind == HIT_BRICK)
+            {
+                hit_brick(w, hits[i].brick);
+            }
+            if (face && hits[i].corner)
+            {
+                continue;
+            }
+            nx = hits[i].nx ? hits[i].nx : nx;
+            ny = hits[i].ny ? hits[i].ny : ny;
+        }
+        reflect(&w->ball_vx[b], nx);
+        reflect(&dx, nx);
+        reflect(&w->ball_vy[b], ny);
+        reflect(&dy, ny);
+    }
+
+    w->ball_x[b] = cx - rad;
+    w->ball_y[b] = cy - rad;
+}
+
+/* ─── Step ────────────────────────────────────────────────────────────────── */
+
+/* Move ball b by one step; false if it fell off the bottom */
+static bool step_ball(bb_world_t *w, int b)
+{
+    w->ball_prev_x[b] = w->ball_x[b];
+    w->ball_prev_y[b] = w->ball_y[b];
+
+    /* the paddle moved onto the ball: put the ball back on top */
+    const bb_rect_t *p = &w->paddle;
+    if (w->ball_vy[b] > 0 && w->ball_y[b] + BALL_SIZE > FX_FROM_INT(p->y) &&
+        w->ball_y[b] < FX_FROM_INT(p->y + p->h) && w->ball_x[b] + BALL_SIZE > FX_FROM_INT(p->x) &&
+        w->ball_x[b] < FX_FROM_INT(p->x + p->w))
+    {
+        w->ball_y[b] = FX_FROM_INT(p->y) - BALL_SIZE - FX_ONE;
+        w->ball_vy[b] = -w->ball_vy[b];
+    }
+
+    /* substeps of at most MAX_SWEEP_PX, covering the step's |v| exactly */
+    fx_t sx = w->ball_vx[b] < 0 ? -w->ball_vx[b] : w->ball_vx[b];
+    fx_t sy = w->ball_vy[b] < 0 ? -w->ball_vy[b] : w->ball_vy[b];
+    int n = (sx > sy ? sx : sy) / FX_FROM_INT(MAX_SWEEP_PX) + 1;
+    for (int i = 0; i < n; i++)
+    {
+        fx_t dx = (fx_t)((int64_t)sx * (i + 1) / n - (int64_t)sx * i / n);
+        fx_t dy = (fx_t)((int64_t)sy * (i + 1) / n - (int64_t)sy * i / n);
+        sweep_ball(w, b, w->ball_vx[b] < 0 ? -dx : dx, w->ball_vy[b] < 0 ? -dy : dy);
+        if (w->ball_y[b] + BALL_SIZE >= FX_FROM_INT(w->h))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Free slot b by moving the last ball into it */
+static void remove_ball(bb_world_t *w, int b)
+{
+    int last = --w->n_balls;
+
+    w->ball_x[b] = w->ball_x[last];
+    w->ball_y[b] = w->ball_y[last];
+    w->ball_vx[b] = w->ball_vx[last];
+    w->ball_vy[b] = w->ball_vy[last];
+    w->ball_prev_x[b] = w->ball_prev_x[last];
+    w->ball_prev_y[b] = w->ball_prev_y[last];
+}
+
+static void apply_powerup(bb_world_t *w, bb_powerup_kind_t kind)
+{
+    switch (kind)
+    {
+    case POWERUP_MULTIBALL:
+    {
+        /* two more balls per ball, at the same speed on other headings */
+        int n = w->n_balls;
+        world_launch(w);
+        for (int b = 0; b < n; b++)
+        {
+            fx_t vx = w->ball_vx[b], vy = w->ball_vy[b];
+            fx_t ax = vx < 0 ? -vx : vx, ay = vy < 0 ? -vy : vy;
+            world_add_ball(w, w->ball_x[b], w->ball_y[b], -vx, vy);
+            world_add_ball(w, w->ball_x[b], w->ball_y[b], vx < 0 ? -ay : ay, -ax);
+        }
+        break;
+    }
+    case POWERUP_WIDE:
+        w->wide_steps = WIDE_STEPS;
+        set_paddle_width(w, w->paddle_base_w * WIDE_SCALE_PCT / 100);
+        break;
+    case POWERUP_LIFE:
+        if (w->lives < MAX_LIVES)
+        {
+            w->lives++;
+            w->changed |= WORLD_CHANGED_LIVES;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* Power-ups fall; the paddle catches them, the bottom loses them */
+static void step_powerups(bb_world_t *w)
+{
+    const bb_rect_t *p = &w->paddle;
+
+    if (w->n_powerups == 0)
+    {
+        return;
+    }
+    for (int i = 0; i < w->n_powerups;)
+    {
+        w->pu_prev_y[i] = w->pu_y[i];
+        w->pu_y[i] += POWERUP_VY;
+
+        bool caught = w->pu_y[i] + FX_FROM_INT(POWERUP_H) > FX_FROM_INT(p->y) &&
+                      w->pu_y[i] < FX_FROM_INT(p->y + p->h) &&
+                      w->pu_x[i] + FX_FROM_INT(POWERUP_W) > FX_FROM_INT(p->x) &&
+                      w->pu_x[i] < FX_FROM_INT(p->x + p->w);
+        if (!caught && w->pu_y[i] < FX_FROM_INT(w->h))
+        {
+            i++;
+            continue;
+        }
+        bb_powerup_kind_t kind = w->pu_kind[i];
+        int last = --w->n_powerups;
+        w->pu_x[i] = w->pu_x[last];
+        w->pu_y[i] = w->pu_y[last];
+        w->pu_prev_y[i] = w->pu_prev_y[last];
+        w->pu_kind[i] = w->pu_kind[last];
+        w->changed |= WORLD_CHANGED_POWERUPS;
+        if (caught)
+        {
+            apply_powerup(w, kind);
+        }
+    }
+}
+
+void world_step(bb_world_t *w)
+{
+    if (world_game_over(w))
+    {
+        return;
+    }
+
+    step_powerups(w);
+    if (w->wide_steps && --w->wide_steps == 0)
+    {
+        set_paddle_width(w, w->paddle_base_w);
+    }
+
+    if (!w->ball_launched)
+    {
+        /* follow the paddle until launch */
+        fx_t x = FX_FROM_INT(w->paddle.x + w->paddle.w / 2 - BALL_RADIUS);
+        if (x != w->ball_x[0])
+        {
+            w->ball_x[0] = x;
+            w->changed |= WORLD_CHANGED_BALL;
+        }
+        w->ball_prev_x[0] = w->ball_x[0];
+        w->ball_prev_y[0] = w->ball_y[0];
+        return;
+    }
+
+    w->changed |= WORLD_CHANGED_BALL;
+    for (int b = 0; b < w->n_balls;)
+    {
+        if (step_ball(w, b))
+        {
+            b++;
+        }
+        else
+        {
+            remove_ball(w, b);
+        }
+    }
+
+    /* bottom: the last ball lost costs a life */
+    if (w->n_balls == 0)
+    {
+        w->lives--;
+        w->changed |= WORLD_CHANGED_LIVES;
+        if (!world_game_over(w))
+        {
+            reset_ball(w);
+        }
+    }
+}
@@ -0,0 +1,224 @@
+/*
+ * tools/bblevel.c
+ *
+ * Host-side converter from a text level layout to the binary level pack
+ * the firmware reads in place (see inc/level.h).
+ *
+ * Build from the brick_breaker/ directory:
+ *     gcc -O2 -I inc -o bblevel tools/bblevel.c src/level.c
+ *
+ * Usage:
+ *     bblevel <levels.txt> <levels.bin>
+ *
+ * Text format, '#' starts a comment:
+ *     type <char> <hits> <rrggbb>   brick type; hits 0 = unbreakable
+ *     level                         starts a level; its rows follow,
+ *                                   one char per brick, '.' for empty
+ *
+ * All rows of a level must be the same length. The pack is checked with
+ * the firmware's loader before it is written.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "level.h"
+
+/* Most levels a pack may hold (n_levels is a byte) */
+#define MAX_LEVELS 255
+/* Largest pack (offsets are 16 bits) */
+#define MAX_PACK 65536
+
+struct text_level
+{
+    int line; /* where it starts, for messages */
+    int rows, cols;
+    char cells[LEVEL_MAX_ROWS][LEVEL_MAX_COLS + 1];
+};
+
+static char type_chars[LEVEL_MAX_TYPES];
+static bb_brick_type_t types[LEVEL_MAX_TYPES];
+static int n_types;
+static struct text_level levels[MAX_LEVELS];
+static int n_levels;
+
+static int type_of(char ch)
+{
+    for (int i = 0; i < n_types; i++)
+    {
+        if (type_chars[i] == ch)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int parse(FILE *f, const char *path)
+{
+    char line[256];
+    int lineno = 0;
+    struct text_level *cur = NULL;
+
+    while (fgets(line, sizeof(line), f))
+    {
+        lineno++;
+        char *hash = strchr(line, '#');
+        if (hash)
+        {
+            *hash = '\0';
+        }
+        char word[64], ch;
+        unsigned int hits, rgb;
+        if (sscanf(line, "%63s", word) != 1)
+        {
+            continue;
+        }
+
+        if (!strcmp(word, "type"))
+        {
+            if (sscanf(line, " type %c %u %x", &ch, &hits, &rgb) != 3 || hits > 255 ||
+                ch == '.' || type_of(ch) >= 0 || n_types == LEVEL_MAX_TYPES)
+            {
+                fprintf(stderr, "%s:%d: bad or duplicate type, or more than %d\n", path,
+                        lineno, LEVEL_MAX_TYPES);
+                return -1;
+            }
+            type_chars[n_types] = ch;
+            types[n_types++] = (bb_brick_type_t){hits, rgb >> 16, (rgb >> 8) & 0xFF, rgb & 0xFF};
+        }
+        else if (!strcmp(word, "level"))
+        {
+            if (n_levels == MAX_LEVELS)
+            {
+                fprintf(stderr, "%s:%d: more than %d levels\n", path, lineno, MAX_LEVELS);
+                return -1;
+            }
+            cur = &levels[n_levels++];
+            cur->line = lineno;
+        }
+        else
+        {
+            int cols = (int)strlen(word);
+            if (!cur || cur->rows == LEVEL_MAX_ROWS || cols > LEVEL_MAX_COLS ||
+                (cur->rows && cols != cur->cols))
+            {
+                fprintf(stderr, "%s:%d: row outside a level, too long (max %d), "
+                        "of another length, or more than %d rows\n",
+                        path, lineno, LEVEL_MAX_COLS, LEVEL_MAX_ROWS);
+                return -1;
+            }
+            for (int c = 0; c < cols; c++)
+            {
+                if (word[c] != '.' && type_of(word[c]) < 0)
+                {
+                    fprintf(stderr, "%s:%d: undefined type '%c'\n", path, lineno, word[c]);
+                    return -1;
+                }
+            }
+            strcpy(cur->cells[cur->rows++], word);
+            cur->cols = cols;
+        }
+    }
+    if (n_types == 0 || n_levels == 0)
+    {
+        fprintf(stderr, "%s: no types or no levels\n", path);
+        return -1;
+    }
+    for (int i = 0; i < n_levels; i++)
+    {
+        if (levels[i].rows == 0)
+        {
+            fprintf(stderr, "%s:%d: empty level\n", path, levels[i].line);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Lay the pack out in buf, return its size */
+static size_t build(uint8_t *buf)
+{
+    bb_level_pack_header_t hdr = {LEVEL_MAGIC, LEVEL_VERSION, (uint8_t)n_types,
+                                  (uint8_t)n_levels, 0};
+    size_t pos = 0;
+
+    /* the header is the only multi-byte field outside the offsets */
+    buf[pos++] = hdr.magic & 0xFF;
+    buf[pos++] = (hdr.magic >> 8) & 0xFF;
+    buf[pos++] = (hdr.magic >> 16) & 0xFF;
+    buf[pos++] = hdr.magic >> 24;
+    buf[pos++] = hdr.version;
+    buf[pos++] = hdr.n_types;
+    buf[pos++] = hdr.n_levels;
+    buf[pos++] = hdr.reserved;
+    memcpy(buf + pos, types, n_types * sizeof(bb_brick_type_t));
+    pos += n_types * sizeof(bb_brick_type_t);
+
+    size_t offsets = pos;
+    pos += 2 * n_levels;
+    for (int i = 0; i < n_levels; i++)
+    {
+        const struct text_level *l = &levels[i];
+
+        buf[offsets + 2 * i] = pos & 0xFF;
+        buf[offsets + 2 * i + 1] = pos >> 8;
+        buf[pos++] = l->rows;
+        buf[pos++] = l->cols;
+        memset(buf + pos, 0, (l->rows * l->cols + 1) / 2);
+        for (int r = 0; r < l->rows; r++)
+        {
+            for (int c = 0; c < l->cols; c++)
+            {
+                int k = r * l->cols + c;
+                int t = l->cells[r][c] == '.' ? 0 : type_of(l->cells[r][c]) + 1;
+                buf[pos + k / 2] |= t << (4 * (k & 1));
+            }
+        }
+        pos += (l->rows * l->cols + 1) / 2;
+    }
+    return pos;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t buf[MAX_PACK + 1024] __attribute__((aligned(4)));
+    bb_level_pack_t pack;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <levels.txt> <levels.bin>\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "r");
+    if (!f)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    int err = parse(f, argv[1]);
+    fclose(f);
+    if (err)
+    {
+        return 1;
+    }
+
+    size_t size = build(buf);
+    if (size > MAX_PACK || level_pack_open(buf, size, &pack) != 0)
+    {
+        fprintf(stderr, "%s: pack over %d bytes, or a level without breakable bricks\n",
+                argv[1], MAX_PACK);
+        return 1;
+    }
+
+    f = fopen(argv[2], "wb");
+    if (!f || fwrite(buf, 1, size, f) != size || fclose(f) != 0)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    printf("%s: %d types, %d levels, %zu bytes (%.1f per level)\n", argv[2], n_types,
+           n_levels, size, (double)size / n_levels);
+    return 0;
+}
@@ -0,0 +1,310 @@
+/*
+ * tools/bbsim.c
+ *
+ * Headless brick breaker simulator and benchmark. Plays full games with
+ * the firmware's own simulation (src/world.c and src/level.c, which use
+ * neither Zephyr nor LVGL) and reports the step rate, the bricks broken
+ * and a checksum of every game's final state. The games depend only on
+ * the seed, the level pack and the paddle input, so the checksum must
+ * not change unless the physics does.
+ *
+ * Build from the brick_breaker/ directory:
+ *     gcc -O2 -I inc -o bbsim tools/bbsim.c src/world.c src/level.c
+ *
+ * Usage:
+ *     bbsim [-n games] [-r seed] [-l levels.bin | -l -] [-i paddle.txt]
+ *           [-m max_steps]
+ *
+ * A game plays the pack's levels in order (the default bricks with -l -)
+ * until the last life is lost, every level is cleared, or max_steps
+ * steps have run. The paddle follows the lowest falling ball, off center
+ * by an amount drawn from the game's seed every two seconds, so some
+ * balls are missed. With -i, the paddle instead takes its x from the
+ * file, one whitespace-separated value per step, repeated as needed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "world.h"
+
+/* Same board as create_ui() on the 480x320 panel */
+#define BOARD_W 480
+#define BOARD_H 320
+/* Steps between changes of the autopilot's aim */
+#define AIM_STEPS (2 * WORLD_STEP_HZ)
+/* Largest pack read */
+#define MAX_PACK 65536
+
+struct totals
+{
+    uint64_t steps, bricks, score;
+    uint32_t levels, game_over, cleared, limit;
+    int best;
+    uint64_t hash;
+};
+
+static bb_level_pack_t pack;
+static bool have_pack;
+static int *script;
+static size_t script_len;
+static long max_steps = 100000;
+
+static uint32_t splitmix32(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t)(x ^ (x >> 31));
+}
+
+static uint32_t xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+/* FNV-1a over n bytes */
+static void hash_bytes(uint64_t *h, const void *p, size_t n)
+{
+    const uint8_t *b = p;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        *h = (*h ^ b[i]) * 0x100000001B3ULL;
+    }
+}
+
+/* Paddle center for this step: from the script, or the autopilot */
+static int paddle_input(const bb_world_t *w, long step, uint32_t *aim_rng, int *aim)
+{
+    if (script)
+    {
+        return script[step % script_len];
+    }
+    if (step % AIM_STEPS == 0)
+    {
+        /* off by up to 5/8 of the paddle: wider than the paddle half plus a ball */
+        *aim = (int)(xorshift32(aim_rng) % (w->paddle.w * 5 / 4 + 1)) - w->paddle.w * 5 / 8;
+    }
+
+    int t = 0;
+    for (int b = 1; b < w->n_balls; b++)
+    {
+        if (w->ball_vy[b] > 0 && (w->ball_vy[t] <= 0 || w->ball_y[b] > w->ball_y[t]))
+        {
+            t = b;
+        }
+    }
+    return FX_TO_INT(w->ball_x[t]) + BALL_RADIUS + *aim;
+}
+
+static void load_level(bb_world_t *w, int i)
+{
+    bb_level_t lvl;
+
+    level_pack_get(&pack, i, &lvl);
+    world_load_level(w, &lvl);
+}
+
+static void play_game(uint32_t seed, struct totals *t)
+{
+    static bb_world_t w;
+    uint32_t aim_rng = splitmix32(seed ^ 0xA5A5A5A5U) | 1;
+    int aim = 0, level = 0;
+    long step;
+
+    world_init(&w, BOARD_W, BOARD_H);
+    w.rng = seed | 1;
+    if (have_pack)
+    {
+        load_level(&w, 0);
+    }
+
+    for (step = 0; step < max_steps && !world_game_over(&w); step++)
+    {
+        if (w.bricks_left == 0)
+        {
+            t->levels++;
+            if (!have_pack || ++level == pack.n_levels)
+            {
+                break;
+            }
+            load_level(&w, level);
+        }
+        world_launch(&w);
+        world_set_paddle(&w, paddle_input(&w, step, &aim_rng, &aim));
+
+        int before = w.bricks_left;
+        world_step(&w);
+        world_clear_changes(&w);
+        t->bricks += before - w.bricks_left;
+    }
+
+    if (world_game_over(&w))
+    {
+        t->game_over++;
+    }
+    else if (step == max_steps)
+    {
+        t->limit++;
+    }
+    else
+    {
+        t->cleared++;
+    }
+    t->steps += step;
+    t->score += w.score;
+    if (w.score > t->best)
+    {
+        t->best = w.score;
+    }
+
+    /* the final state, field by field so padding does not count */
+    hash_bytes(&t->hash, &step, sizeof(step));
+    hash_bytes(&t->hash, &level, sizeof(level));
+    hash_bytes(&t->hash, &w.score, sizeof(w.score));
+    hash_bytes(&t->hash, &w.lives, sizeof(w.lives));
+    hash_bytes(&t->hash, &w.bricks_left, sizeof(w.bricks_left));
+    hash_bytes(&t->hash, w.brick_alive, sizeof(w.brick_alive));
+    hash_bytes(&t->hash, w.brick_hits, sizeof(w.brick_hits));
+    hash_bytes(&t->hash, &w.paddle, sizeof(w.paddle));
+    hash_bytes(&t->hash, &w.n_balls, sizeof(w.n_balls));
+    hash_bytes(&t->hash, w.ball_x, w.n_balls * sizeof(fx_t));
+    hash_bytes(&t->hash, w.ball_y, w.n_balls * sizeof(fx_t));
+    hash_bytes(&t->hash, w.ball_vx, w.n_balls * sizeof(fx_t));
+    hash_bytes(&t->hash, w.ball_vy, w.n_balls * sizeof(fx_t));
+    hash_bytes(&t->hash, &w.n_powerups, sizeof(w.n_powerups));
+    hash_bytes(&t->hash, w.pu_y, w.n_powerups * sizeof(fx_t));
+    hash_bytes(&t->hash, &w.rng, sizeof(w.rng));
+}
+
+static int read_pack(const char *path)
+{
+    static uint8_t buf[MAX_PACK] __attribute__((aligned(4)));
+    FILE *f = fopen(path, "rb");
+
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+    size_t size = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    if (level_pack_open(buf, size, &pack) != 0)
+    {
+        fprintf(stderr, "%s: not a valid level pack\n", path);
+        return -1;
+    }
+    have_pack = true;
+    return 0;
+}
+
+static int read_script(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    size_t cap = 0;
+    int x;
+
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+    while (fscanf(f, "%d", &x) == 1)
+    {
+        if (script_len == cap)
+        {
+            cap = cap ? 2 * cap : 1024;
+            script = realloc(script, cap * sizeof(*script));
+            if (!script)
+            {
+                fprintf(stderr, "out of memory\n");
+                fclose(f);
+                return -1;
+            }
+        }
+        script[script_len++] = x;
+    }
+    fclose(f);
+    if (script_len == 0)
+    {
+        fprintf(stderr, "%s: no paddle positions\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *levels = "data/levels.bin", *input = NULL;
+    uint32_t games = 1000, seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:l:i:m:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            games = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            levels = optarg;
+            break;
+        case 'i':
+            input = optarg;
+            break;
+        case 'm':
+            max_steps = strtol(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n games] [-r seed] [-l levels.bin | -l -] "
+                            "[-i paddle.txt] [-m max_steps]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (games == 0 || max_steps <= 0)
+    {
+        fprintf(stderr, "bad -n or -m\n");
+        return 2;
+    }
+    if ((strcmp(levels, "-") && read_pack(levels)) || (input && read_script(input)))
+    {
+        return 1;
+    }
+
+    struct totals t = {.hash = 0xCBF29CE484222325ULL};
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t g = 0; g < games; g++)
+    {
+        play_game(splitmix32(((uint64_t)seed << 32) | g), &t);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double dt = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    printf("bbsim: %u games, seed %u, %s, %s, %d Hz steps, %.2f s\n", games, seed,
+           have_pack ? levels : "default bricks", input ? input : "autopilot", WORLD_STEP_HZ,
+           dt);
+    printf("  %llu steps, %.2f M steps/s, %.0f steps/game\n", (unsigned long long)t.steps,
+           t.steps / dt / 1e6, (double)t.steps / games);
+    printf("  %llu bricks broken (%.1f/game), %u levels cleared, score mean %.0f max %d\n",
+           (unsigned long long)t.bricks, (double)t.bricks / games, t.levels,
+           (double)t.score / games, t.best);
+    printf("  ended: %u game over, %u all cleared, %u step limit\n", t.game_over, t.cleared,
+           t.limit);
+    printf("  checksum %016llx\n", (unsigned long long)t.hash);
+    return 0;
+}